@@ -17,23 +17,36 @@ Distributed under the MIT License
 
 namespace med {
 
+//no space to allocate from (the caller reports out_of_memory to its context)
 struct null_allocator
 {
 	[[nodiscard]]
-	void* allocate(std::size_t bytes, std::size_t /*alignment*/) const
+	void* allocate(std::size_t /*bytes*/, std::size_t /*alignment*/) const noexcept
 	{
 		CODEC_TRACE("%s", __FUNCTION__);
-		MED_THROW_EXCEPTION(out_of_memory, __FUNCTION__, bytes);
+		return nullptr;
 	}
 };
 
+//instance of T or nullptr when out of space
 template <typename T, class ALLOCATOR, class... ARGs>
 T* create(ALLOCATOR& alloc, ARGs&&... args)
 {
 	CODEC_TRACE("%s", __FUNCTION__);
 	void* p = alloc.allocate(sizeof(T), alignof(T));
-	if (!p) { MED_THROW_EXCEPTION(out_of_memory, name<T>(), sizeof(T)); }
-	return new (p) T{std::forward<ARGs>(args)...};
+	return p ? new (p) T{std::forward<ARGs>(args)...} : nullptr;
+}
+
+//default constructed array of T in contiguous memory or nullptr when out of space
+template <typename T, class ALLOCATOR>
+T* create_array(ALLOCATOR& alloc, std::size_t count)
+{
+	CODEC_TRACE("%s[%zu]", __FUNCTION__, count);
+	void* p = alloc.allocate(sizeof(T) * count, alignof(T));
+	if (!p) { return nullptr; }
+	auto* pt = static_cast<T*>(p);
+	for (std::size_t i = 0; i < count; ++i) { new (pt + i) T{}; }
+	return pt;
 }
 
 namespace detail {
@@ -0,0 +1,162 @@
+/**
+@file
+growable allocator chaining blocks from upstream memory resource
+
+@copyright Denis Priyomov 2016-2017
+Distributed under the MIT License
+(See accompanying file LICENSE or visit https://github.com/cppden/med)
+*/
+
+#pragma once
+
+#include <memory_resource>
+
+#include "allocator.hpp"
+
+namespace med {
+
+/**
+ * Bump allocator which takes extra blocks from upstream memory resource when
+ * the current block is exhausted, so the initial space can be sized for the
+ * typical message instead of the worst case.
+ * The blocks are kept on release (to reset per message) and reused in the
+ * same order, they are given back to upstream by trim or on destruction.
+ * NOTE: w/o upstream it's the same as med::allocator.
+ */
+class arena_allocator
+{
+public:
+	arena_allocator(arena_allocator const&) = delete;
+	arena_allocator& operator=(arena_allocator const&) = delete;
+
+	/**
+	 * @param upstream source of extra blocks (e.g. pool resource)
+	 * @param block_size min size of extra block to request
+	 */
+	explicit arena_allocator(std::pmr::memory_resource* upstream = std::pmr::get_default_resource(), std::size_t block_size = 4096) noexcept
+		: m_upstream{upstream}, m_block_size{block_size}
+	{}
+
+	arena_allocator(void* data, std::size_t size, std::pmr::memory_resource* upstream = std::pmr::get_default_resource(), std::size_t block_size = 4096) noexcept
+		: arena_allocator{upstream, block_size}
+	{
+		reset(data, size);
+	}
+
+	template <typename T, std::size_t SIZE>
+	explicit arena_allocator(T (&data)[SIZE], std::pmr::memory_resource* upstream = std::pmr::get_default_resource(), std::size_t block_size = 4096) noexcept
+		: arena_allocator{data, SIZE * sizeof(T), upstream, block_size}
+	{}
+
+	~arena_allocator()                                { trim(); }
+
+	/**
+	 * Resets to the start of initial space keeping the blocks chained for reuse
+	 */
+	void release() noexcept
+	{
+		m_begin = m_start;
+		m_size = m_total;
+		m_curr = nullptr;
+		m_next = m_chain;
+	}
+
+	/**
+	 * Resets to new initial space
+	 * @param data start of initial space
+	 * @param size size of initial space
+	 */
+	void reset(void* data, std::size_t size) noexcept
+	{
+		m_start = data;
+		m_total = size;
+		release();
+	}
+
+	template <typename T, std::size_t SIZE>
+	void reset(T (&data)[SIZE]) noexcept              { reset(data, SIZE * sizeof(T)); }
+
+	/**
+	 * Releases and gives all chained blocks back to upstream
+	 */
+	void trim() noexcept
+	{
+		while (auto* p = m_chain)
+		{
+			m_chain = p->next;
+			m_upstream->deallocate(p, sizeof(block) + p->size, alignof(block));
+		}
+		release();
+	}
+
+	//total size of blocks taken from upstream
+	std::size_t chained() const noexcept
+	{
+		std::size_t total = 0;
+		for (auto* p = m_chain; p; p = p->next) { total += p->size; }
+		return total;
+	}
+
+	/**
+	 * Allocates from the current block or the next one
+	 * @return pointer to allocated space or nullptr when out of space w/o upstream
+	 */
+	[[nodiscard]]
+	void* allocate(std::size_t bytes, std::size_t alignment)
+	{
+		if (void* p = std::align(alignment, bytes, m_begin, m_size))
+		{
+			m_begin = static_cast<uint8_t*>(m_begin) + bytes;
+			m_size -= bytes;
+			return p;
+		}
+		return expand(bytes, alignment);
+	}
+
+private:
+	struct alignas(std::max_align_t) block
+	{
+		block*      next;
+		std::size_t size; //of data following the header
+	};
+
+	//slow path: switch to the next block in chain or take new one from upstream
+	void* expand(std::size_t bytes, std::size_t alignment)
+	{
+		if (!m_upstream) { return nullptr; }
+
+		auto const need = bytes + alignment - 1;
+		block* p = m_next;
+		if (p && p->size >= need)
+		{
+			m_next = p->next;
+		}
+		else
+		{
+			auto const size = std::max(m_block_size, need);
+			CODEC_TRACE("%s: new block %zu for %zu", __FUNCTION__, size, bytes);
+			p = static_cast<block*>(m_upstream->allocate(sizeof(block) + size, alignof(block)));
+			//insert before the next to keep the order of reuse
+			p->next = m_next;
+			p->size = size;
+			(m_curr ? m_curr->next : m_chain) = p;
+		}
+		m_curr = p;
+		m_begin = p + 1;
+		m_size = p->size;
+		return allocate(bytes, alignment);
+	}
+
+	void*       m_begin {};
+	std::size_t m_size {};
+	void*       m_start {};
+	std::size_t m_total {};
+
+	std::pmr::memory_resource* m_upstream;
+	std::size_t m_block_size;
+	block*      m_chain {nullptr}; //all blocks taken from upstream
+	block*      m_curr {nullptr};  //block in use or null for initial space
+	block*      m_next {nullptr};  //block to continue with
+};
+
+} //end: namespace med
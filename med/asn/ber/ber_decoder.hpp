@@ -60,26 +60,30 @@ struct decoder : info
 	{
 		constexpr std::size_t NUM_BYTES = bits_to_bytes(IE::traits::bits);
 		uint8_t const* input = get_context().buffer().template advance<IE, NUM_BYTES>();
+		MED_RETURN_ON_ERROR(*this);
 		std::size_t const vtag = get_bytes<NUM_BYTES>(input);
 		CODEC_TRACE("T=%zX [%s] %zu bits: %s", vtag, name<IE>(), IE::traits::bits, get_context().buffer().toString());
 		return vtag;
 	}
 	//IE_LEN
-	template <class IE> void operator() (IE& ie, IE_LEN)
+	template <class IE> MED_RESULT operator() (IE& ie, IE_LEN)
 	{
 		//CODEC_TRACE("LEN[%s]: %s", name<IE>(), get_context().buffer().toString());
 		auto const len = ber_length<IE>();
+		MED_RETURN_ON_ERROR(*this);
 		ie.set_encoded(len);
 		CODEC_TRACE("L=%zX [%s]: %s", len, name<IE>(), get_context().buffer().toString());
+		MED_RETURN_SUCCESS;
 	}
 
 	//IE_NULL
-	template <class IE> constexpr void operator() (IE&, IE_NULL) const
+	template <class IE> constexpr MED_RESULT operator() (IE&, IE_NULL) const
 	{
+		MED_RETURN_SUCCESS;
 	}
 
 	//IE_VALUE
-	template <class IE> void operator() (IE& ie, IE_VALUE)
+	template <class IE> MED_RESULT operator() (IE& ie, IE_VALUE)
 	{
 		if constexpr (is_seqof_v<IE>)
 		{
@@ -87,9 +91,10 @@ struct decoder : info
 			while (this->operator()(CHECK_STATE{}, ie))
 			{
 				auto* field = ie.push_back(*this);
-				decode(*this, *field);
+				MED_RETURN_ON_ERROR(*this);
+				MED_CHECK_FAIL(decode(*this, *field));
 			}
-			check_arity(*this, ie);
+			return check_arity(*this, ie);
 		}
 		else if constexpr (is_oid_v<IE>)
 		{
@@ -97,9 +102,10 @@ struct decoder : info
 			while (this->operator()(CHECK_STATE{}, ie))
 			{
 				auto* field = ie.push_back(*this);
-				this->operator()(*field, IE_VALUE{});
+				MED_RETURN_ON_ERROR(*this);
+				MED_CHECK_FAIL(this->operator()(*field, IE_VALUE{}));
 			}
-			check_arity(*this, ie);
+			return check_arity(*this, ie);
 		}
 		else
 		{
@@ -107,7 +113,10 @@ struct decoder : info
 			if constexpr (std::is_same_v<bool, typename IE::value_type>)
 			{
 				//X.690 8.2 Encoding of a boolean value
-				return ie.set_encoded(get_context().buffer().template pop<IE>() != 0);
+				auto const val = get_context().buffer().template pop<IE>();
+				MED_RETURN_ON_ERROR(*this);
+				ie.set_encoded(val != 0);
+				MED_RETURN_SUCCESS;
 			}
 			else if constexpr (std::is_integral_v<typename IE::value_type>)
 			{
@@ -117,7 +126,11 @@ struct decoder : info
 				{
 					CODEC_TRACE("\t%zu octets: %s", len, get_context().buffer().toString());
 					auto* input = get_context().buffer().template advance<IE>(len); //value
-					ie.set_encoded(read_bytes<typename IE::value_type>(input, len));
+					MED_RETURN_ON_ERROR(*this);
+					auto const val = read_bytes<typename IE::value_type>(input, len);
+					MED_RETURN_ON_ERROR(*this);
+					ie.set_encoded(val);
+					MED_RETURN_SUCCESS;
 				}
 				else
 				{
@@ -136,15 +149,18 @@ struct decoder : info
 	}
 
 	//IE_BIT_STRING
-	template <class IE> void operator() (IE& ie, IE_BIT_STRING)
+	template <class IE> MED_RESULT operator() (IE& ie, IE_BIT_STRING)
 	{
 		auto const unused_bits = get_context().buffer().template pop<IE>(); //num of unused bits [0..7]
+		MED_RETURN_ON_ERROR(*this);
 		auto const len = get_context().buffer().size();
 		std::size_t const num_bits = len * 8 - unused_bits;
 		CODEC_TRACE("\tBSTR[%s] %zu bits: %s", name<IE>(), num_bits, get_context().buffer().toString());
 		if (ie.set_encoded(num_bits, get_context().buffer().begin()))
 		{
 			get_context().buffer().template advance<IE>(len);
+			MED_RETURN_ON_ERROR(*this);
+			MED_RETURN_SUCCESS;
 		}
 		else
 		{
@@ -153,13 +169,15 @@ struct decoder : info
 	}
 
 	//IE_OCTET_STRING
-	template <class IE> void operator() (IE& ie, IE_OCTET_STRING)
+	template <class IE> MED_RESULT operator() (IE& ie, IE_OCTET_STRING)
 	{
 		auto const len = get_context().buffer().size();
 		CODEC_TRACE("\tOSTR[%s] %zu octets: %s", name<IE>(), len, get_context().buffer().toString());
 		if (ie.set_encoded(len, get_context().buffer().begin()))
 		{
 			get_context().buffer().template advance<IE>(len);
+			MED_RETURN_ON_ERROR(*this);
+			MED_RETURN_SUCCESS;
 		}
 		else
 		{
@@ -175,13 +193,16 @@ private:
 	std::size_t ber_length()
 	{
 		uint8_t bytes = get_context().buffer().template pop<IE>();
+		MED_RETURN_ON_ERROR(*this);
 		//short form
 		if (bytes < 0x80) { return bytes; }
 
 		bytes &= 0x7F;
 		if (bytes)
 		{
-			return read_bytes<std::size_t>(get_context().buffer().template advance<IE>(bytes), bytes);
+			auto const* input = get_context().buffer().template advance<IE>(bytes);
+			MED_RETURN_ON_ERROR(*this);
+			return read_bytes<std::size_t>(input, bytes);
 		}
 		else //indefinite form (X.690 8.1.3.6)
 		//8.1.3.6 length octets indicate that the contents octets are terminated by end-of-contents octets
@@ -192,7 +213,7 @@ private:
 	}
 
 	template <typename T>
-	static T read_bytes(uint8_t const* input, uint8_t num_bytes)
+	T read_bytes(uint8_t const* input, uint8_t num_bytes)
 	{
 		//TODO: template to unwrap w/o duck-typing and allow char/short/int/long...
 		switch (num_bytes)
@@ -205,7 +226,7 @@ private:
 		case 6: if constexpr (sizeof(T) >= 6) return signextend<T, 48>((T(input[0]) << 40) | (T(input[1]) << 32) | (T(input[2]) << 24) | (T(input[3])<<16) | (T(input[4])<< 8) | (T(input[5])) );
 		case 7: if constexpr (sizeof(T) >= 7) return signextend<T, 56>((T(input[0]) << 48) | (T(input[1]) << 40) | (T(input[2]) << 32) | (T(input[3])<<24) | (T(input[4])<<16) | (T(input[5])<< 8) | (T(input[6])) );
 		case 8: if constexpr (sizeof(T) >= 8) return signextend<T, 64>((T(input[0]) << 56) | (T(input[1]) << 48) | (T(input[2]) << 40) | (T(input[3])<<32) | (T(input[4])<<24) | (T(input[5])<<16) | (T(input[6])<<8) | (T(input[7])));
-		default: MED_THROW_EXCEPTION(invalid_value, __FUNCTION__, num_bytes)
+		default: MED_THROW_EXCEPTION(invalid_value, __FUNCTION__, num_bytes, *this)
 		}
 	}
 
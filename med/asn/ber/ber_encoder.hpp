@@ -34,7 +34,7 @@ struct encoder : info
 	auto operator() (GET_STATE)                       { return get_context().buffer().get_state(); }
 	void operator() (SET_STATE, state_type const& st) { get_context().buffer().set_state(st); }
 	template <class IE>
-	void operator() (SET_STATE, IE const& ie)
+	MED_RESULT operator() (SET_STATE, IE const& ie)
 	{
 		if (auto const ss = get_context().get_snapshot(ie))
 		{
@@ -42,6 +42,7 @@ struct encoder : info
 			if (ss.validate_length(len))
 			{
 				get_context().buffer().set_state(ss);
+				MED_RETURN_SUCCESS;
 			}
 			else
 			{
@@ -57,8 +58,13 @@ struct encoder : info
 	template <class IE>
 	bool operator() (PUSH_STATE, IE const&)             { return get_context().buffer().push_state(); }
 	void operator() (POP_STATE)                         { get_context().buffer().pop_state(); }
-	void operator() (ADVANCE_STATE ss)                  { get_context().buffer().template advance<ADVANCE_STATE>(ss.delta); }
-	void operator() (SNAPSHOT ss)                       { get_context().put_snapshot(ss); }
+	MED_RESULT operator() (ADVANCE_STATE ss)
+	{
+		get_context().buffer().template advance<ADVANCE_STATE>(ss.delta);
+		MED_RETURN_ON_ERROR(*this);
+		MED_RETURN_SUCCESS;
+	}
+	MED_RESULT operator() (SNAPSHOT ss)                 { return get_context().put_snapshot(ss); }
 
 	//calculate length of IE (can be either a data itself or TAG/LEN already extracted from META-INFO
 	template <class IE>
@@ -144,57 +150,65 @@ struct encoder : info
 	}
 
 	//IE_TAG
-	template <class IE> void operator() (IE const& ie, IE_TAG)
+	template <class IE> MED_RESULT operator() (IE const& ie, IE_TAG)
 	{
 		constexpr std::size_t nbytes = bits_to_bytes(IE::traits::bits);
 		uint8_t* out = get_context().buffer().template advance<IE, nbytes>();
+		MED_RETURN_ON_ERROR(*this);
 		CODEC_TRACE("tag[%s]=%zXh %zu bytes: %s", name<IE>(), std::size_t(ie.get()), nbytes, get_context().buffer().toString());
 		put_bytes<nbytes>(ie.get(), out);
+		MED_RETURN_SUCCESS;
 	}
 
 	//IE_LEN
-	template <class IE> void operator() (IE const& ie, IE_LEN)
+	template <class IE> MED_RESULT operator() (IE const& ie, IE_LEN)
 	{
 		CODEC_TRACE("len[%s]=%zXh: %s", name<IE>(), std::size_t(ie.get()), get_context().buffer().toString());
-		ber_length<IE>(ie.get());
+		return ber_length<IE>(ie.get());
 	}
 
 
 	//IE_NULL
-	template <class IE> constexpr void operator() (IE const&, IE_NULL) const
+	template <class IE> constexpr MED_RESULT operator() (IE const&, IE_NULL) const
 	{
 		//X.690 8.8 Encoding of a null value
 		//8.8.2 The contents octets shall not contain any octets.
 		//NOTE – The length octet is zero.
 		//length(encoded via IE_LEN) + no value
+		MED_RETURN_SUCCESS;
 	}
 
 	//IE_VALUE
-	template <class IE> void operator() (IE const& ie, IE_VALUE)
+	template <class IE> MED_RESULT operator() (IE const& ie, IE_VALUE)
 	{
 		//TODO: normally this is handled in sequence/set but ASN.1 has seq-of/set-of :(
 		if constexpr (is_seqof_v<IE>)
 		{
 			CODEC_TRACE("SEQOF[%s] *%zu", name<IE>(), ie.count());
-			sl::encode_multi(*this, ie);
+			return sl::encode_multi(*this, ie);
 		}
 		else if constexpr (is_oid_v<IE>)
 		{
 			CODEC_TRACE("OID[%s] *%zu", name<IE>(), ie.count());
+			//NOTE: advancing once for all subidentifiers to write in order into any buffer
+			std::size_t len = 0;
 			for (auto& field : ie)
 			{
-				if (field.is_set())
+				if (not field.is_set())
 				{
-					auto const encoded = detail::encode_unsigned(field.get());
-					auto const len = detail::least_bytes_encoded(field.get());
-					uint8_t* out = get_context().buffer().template advance<IE>(len); //value
-					write_bytes(encoded, out, len); //value
-				}
-				else
-				{
-					MED_THROW_EXCEPTION(missing_ie, name<IE>(), ie.count(), ie.count() - 1)
+					MED_THROW_EXCEPTION(missing_ie, name<IE>(), ie.count(), ie.count() - 1, *this)
 				}
+				len += detail::least_bytes_encoded(field.get());
 			}
+			uint8_t* out = get_context().buffer().template advance<IE>(len); //value
+			MED_RETURN_ON_ERROR(*this);
+			for (auto& field : ie)
+			{
+				auto const num_bytes = detail::least_bytes_encoded(field.get());
+				MED_CHECK_FAIL(write_bytes(detail::encode_unsigned(field.get()), out, num_bytes));
+				out += num_bytes;
+			}
+			MED_RETURN_SUCCESS;
 		}
 		else
 		{
@@ -202,8 +216,9 @@ struct encoder : info
 			if constexpr (std::is_same_v<bool, value_type>)
 			{
 				//X.690 8.2 Encoding of a boolean value
-				get_context().buffer().template push<IE>(ie.get_encoded() ? 0xFF : 0x00);
+				MED_CHECK_FAIL(get_context().buffer().template push<IE>(ie.get_encoded() ? 0xFF : 0x00));
 				CODEC_TRACE("BOOL[%s]=%zXh: %s", name<IE>(), std::size_t(ie.get_encoded()), get_context().buffer().toString());
+				MED_RETURN_SUCCESS;
 			}
 			else if constexpr (std::is_integral_v<value_type>)
 			{
@@ -211,9 +226,11 @@ struct encoder : info
 				//X.690 8.4 Encoding of an enumerated value
 				auto const len = length::bytes<value_type>(ie.get_encoded());
 				uint8_t* out = get_context().buffer().template advance<IE>(len); //value
+				MED_RETURN_ON_ERROR(*this);
 				//*out++ = len; //length in 1 byte, no sense in more than 9 (17 in future?) bytes for integer
-				write_bytes(ie.get_encoded(), out, len); //value
+				MED_CHECK_FAIL(write_bytes(ie.get_encoded(), out, len)); //value
 				CODEC_TRACE("INT[%s]=%lld %u bytes: %s", name<IE>(), (long long)ie.get_encoded(), len, get_context().buffer().toString());
+				MED_RETURN_SUCCESS;
 			}
 			else if constexpr (std::is_floating_point_v<value_type>)
 			{
@@ -228,33 +245,37 @@ struct encoder : info
 	}
 
 	//IE_BIT_STRING
-	template <class IE> void operator() (IE const& ie, IE_BIT_STRING)
+	template <class IE> MED_RESULT operator() (IE const& ie, IE_BIT_STRING)
 	{
 		//X.690 8.6 Encoding of a bitstring value (not segmented only)
 		//8.6.2.2 The initial octet shall encode, as an unsigned binary integer,
 		// the number of unused bits in the final subsequent octet in the range [0..7].
 		//8.6.2.3 If the bitstring is empty, there shall be no subsequent octets, and the initial
 		// octet shall be zero.
-		get_context().buffer().template push<IE>( uint8_t(8 - uint8_t(ie.get().least_bits())) );
-		auto* out = get_context().buffer().template advance<IE>(ie.size());
+		auto* out = get_context().buffer().template advance<IE>(1 + ie.size());
+		MED_RETURN_ON_ERROR(*this);
+		*out++ = uint8_t(8 - uint8_t(ie.get().least_bits()));
 		octets<IE::traits::min_bits/8, IE::traits::max_bits/8>::copy(out, ie.data(), ie.size());
 		CODEC_TRACE("STR[%s] %zu bits: %s", name<IE>(), std::size_t(ie.get().num_of_bits()), get_context().buffer().toString());
+		MED_RETURN_SUCCESS;
 	}
 
 	//IE_OCTET_STRING
-	template <class IE> void operator() (IE const& ie, IE_OCTET_STRING)
+	template <class IE> MED_RESULT operator() (IE const& ie, IE_OCTET_STRING)
 	{
 		//X.690 8.7 Encoding of an octetstring value (not segmented only)
 		auto* out = get_context().buffer().template advance<IE>(ie.size());
+		MED_RETURN_ON_ERROR(*this);
 		octets<IE::traits::min_octets, IE::traits::max_octets>::copy(out, ie.data(), ie.size());
 		CODEC_TRACE("STR[%s] %zu octets: %s", name<IE>(), ie.size(), get_context().buffer().toString());
+		MED_RETURN_SUCCESS;
 	}
 
 #ifndef UNIT_TEST
 private:
 #endif
 	template <class IE>
-	void ber_length(std::size_t len)
+	MED_RESULT ber_length(std::size_t len)
 	{
 		// X.690
 		// 8.1.3.3 in definite form length octets consist of 1+ octets,
@@ -262,7 +283,7 @@ private:
 		if (len < 0x80)
 		{
 			// 8.1.3.4 short form can only be used when length <= 127.
-			get_context().buffer().template push<IE>(len);
+			return get_context().buffer().template push<IE>(len);
 		}
 		else
 		{
@@ -273,13 +294,14 @@ private:
 			// Subsequent octets encode as unsigned binary integer equal to the the length value.
 			uint8_t const bytes = length::bytes(len);
 			uint8_t* out = get_context().buffer().template advance<IE>(1 + bytes);
+			MED_RETURN_ON_ERROR(*this);
 			*out++ = bytes | 0x80;
-			write_bytes(len, out, bytes);
+			return write_bytes(len, out, bytes);
 		}
 	}
 
 	template <typename T>
-	static void write_bytes(T const value, uint8_t* output, uint8_t num_bytes)
+	MED_RESULT write_bytes(T const value, uint8_t* output, uint8_t num_bytes)
 	{
 		switch (num_bytes)
 		{
@@ -291,8 +313,9 @@ private:
 		case 6: if constexpr (sizeof(T) >= 6) { put_bytes<6>(value, output); break; }
 		case 7: if constexpr (sizeof(T) >= 7) { put_bytes<7>(value, output); break; }
 		case 8: if constexpr (sizeof(T) >= 8) { put_bytes<8>(value, output); break; }
-		default: MED_THROW_EXCEPTION(invalid_value, __FUNCTION__, num_bytes)
+		default: MED_THROW_EXCEPTION(invalid_value, __FUNCTION__, num_bytes, *this)
 		}
+		MED_RETURN_SUCCESS;
 	}
 
 	ENC_CTX& m_ctx;
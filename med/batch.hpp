@@ -0,0 +1,210 @@
+/**
+@file
+encoding and decoding of many messages in a batch
+
+@copyright Denis Priyomov 2016-2017
+Distributed under the MIT License
+(See accompanying file LICENSE or visit https://github.com/cppden/med)
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <ranges>
+#include <span>
+
+#include "encode.hpp"
+#include "decode.hpp"
+#include "layout.hpp"
+
+namespace med {
+
+//location of message encoded in batch
+struct batch_entry
+{
+	std::size_t buffer; //index of buffer in the chain
+	std::size_t offset; //from the start of buffer
+	std::size_t size;
+};
+
+namespace detail {
+
+//overflow is the end of space rather than the failure of batch
+template <class ENCODER, class IE>
+bool encode_fits(ENCODER& encoder, IE const& ie)
+{
+#ifdef MED_NO_EXCEPTION
+	if (encode(encoder, ie)) { return true; }
+	auto& err = get_error_ctx(encoder.get_context());
+	if (err.get_error() == error::overflow) { err.reset(); }
+	return false;
+#else
+	try
+	{
+		encode(encoder, ie);
+		return true;
+	}
+	catch (overflow const&)
+	{
+		return false;
+	}
+#endif
+}
+
+//failure of decoding as status
+template <class DECODER, class IE>
+error decode_status(DECODER& decoder, IE& ie)
+{
+#ifdef MED_NO_EXCEPTION
+	return decode(decoder, ie) ? error::success : get_error_ctx(decoder.get_context()).get_error();
+#else
+	try
+	{
+		decode(decoder, ie);
+		return error::success;
+	}
+	catch (overflow const&)      { return error::overflow; }
+	catch (invalid_value const&) { return error::invalid_value; }
+	catch (unknown_tag const&)   { return error::unknown_tag; }
+	catch (missing_ie const&)    { return error::missing_ie; }
+	catch (extra_ie const&)      { return error::extra_ie; }
+	catch (out_of_memory const&) { return error::out_of_memory; }
+#endif
+}
+
+} //end: namespace detail
+
+/**
+ * Encodes the messages back-to-back into the buffer of encoder's context
+ * starting from its current state. The context with its allocator and the
+ * buffer checks are shared by the batch. The message which doesn't fit is
+ * rolled back so the buffer can be flushed and the batch continued from it.
+ * @param encoder encoder to use for each message
+ * @param msgs range of messages to encode
+ * @param entries output location of each message encoded (buffer index is 0)
+ * @return number of messages encoded i.e. index of the 1st one not fit
+ * NOTE: w/o exceptions other errors also stop the batch (see get_error_ctx)
+ * NOTE: the snapshots are reset per message so the ones of the last message
+ *       encoded only are kept to update (none if it was rolled back)
+ */
+template <class ENCODER, std::ranges::forward_range MSGS>
+std::size_t encode_batch(ENCODER&& encoder, MSGS const& msgs, std::span<batch_entry> entries)
+{
+	auto& ctx = encoder.get_context();
+	auto& buf = ctx.buffer();
+	static_assert(!requires { std::remove_reference_t<decltype(buf)>::reverse; }, "FORWARD BUFFER IS EXPECTED");
+
+	std::size_t num = 0;
+	for (auto it = std::ranges::begin(msgs); it != std::ranges::end(msgs) && num < entries.size(); ++it, ++num)
+	{
+		auto const start = buf.get_state();
+		auto const offset = buf.get_offset();
+		ctx.reset_snapshots();
+		if (not detail::encode_fits(encoder, *it))
+		{
+			CODEC_TRACE("batch: #%zu doesn't fit at %zu", num, offset);
+			buf.set_state(start);
+			ctx.reset_snapshots();
+			break;
+		}
+		entries[num] = {0, offset, buf.get_offset() - offset};
+	}
+	return num;
+}
+
+/**
+ * Encodes the messages back-to-back into the chain of buffers moving on to
+ * the next buffer when the message doesn't fit in the current one.
+ * @param encoder encoder to use for each message
+ * @param msgs range of messages to encode
+ * @param entries output location of each message encoded
+ * @param chain buffers (e.g. spans of octets) to encode into one by one
+ * @return number of messages encoded i.e. index of the 1st one not fit
+ */
+template <class ENCODER, std::ranges::forward_range MSGS, std::ranges::random_access_range CHAIN>
+std::size_t encode_batch(ENCODER&& encoder, MSGS const& msgs, std::span<batch_entry> entries, CHAIN const& chain)
+{
+	std::size_t num = 0;
+	auto it = std::ranges::begin(msgs);
+	for (std::size_t i = 0; i < std::ranges::size(chain) && it != std::ranges::end(msgs) && num < entries.size(); ++i)
+	{
+		encoder.get_context().reset(std::ranges::data(chain[i]), std::ranges::size(chain[i]));
+		auto const n = encode_batch(encoder, std::ranges::subrange(it, std::ranges::end(msgs)), entries.subspan(num));
+		for (auto& e : entries.subspan(num, n)) { e.buffer = i; }
+		num += n;
+		std::ranges::advance(it, n);
+		if (get_error_ctx(encoder.get_context())) { break; }
+	}
+	return num;
+}
+
+/**
+ * Decodes the packets (e.g. received by recvmmsg) into the messages in tight
+ * loop with the context and its allocator shared by the batch: the context is
+ * reset to each packet while the allocator is to be released by the caller
+ * once the messages are processed.
+ * @param decoder decoder to use for each packet
+ * @param packets range of encoded packets (e.g. spans of octets)
+ * @param msgs messages to decode into, one per packet, reset before decoding
+ * @param status output result of each packet
+ * @return number of packets decoded successfully
+ * NOTE: the failure of packet is reported in its status only and not thrown
+ */
+template <class DECODER, std::ranges::random_access_range PACKETS, std::ranges::random_access_range MSGS>
+std::size_t decode_batch(DECODER&& decoder, PACKETS const& packets, MSGS& msgs, std::span<error> status)
+{
+	auto& ctx = decoder.get_context();
+	auto const num = std::min({std::size_t(std::ranges::size(packets)), std::size_t(std::ranges::size(msgs)), status.size()});
+	std::size_t decoded = 0;
+	for (std::size_t i = 0; i < num; ++i)
+	{
+		auto& msg = std::ranges::begin(msgs)[i];
+		auto const& packet = std::ranges::begin(packets)[i];
+		if constexpr (requires { msg.reset(); }) { msg.reset(); } //drop cold IEs of released allocator
+		else { msg.clear(); }
+		ctx.reset(std::ranges::data(packet), std::ranges::size(packet));
+		status[i] = detail::decode_status(decoder, msg);
+		CODEC_TRACE("batch: #%zu decoded=%u", i, unsigned(status[i]));
+		if (status[i] == error::success) { ++decoded; }
+	}
+	return decoded;
+}
+
+/**
+ * Extracts the fields of fixed layout (see fixed_layout) from the packets into
+ * own array per field (structure of arrays) w/o decoding the messages. Each
+ * field is extracted by a separate loop over the packets with the native size
+ * loaded at once and byte-swapped so the loop can be vectorized.
+ * @tparam MSG sequence with the leading fields of fixed layout
+ * @tparam FIELDS fields to extract
+ * @param packets range of encoded packets (e.g. spans of octets)
+ * @param outs arrays for the encoded values of each field, one per packet
+ * @return number of packets extracted i.e. index of the 1st one too short
+ */
+template <class MSG, class... FIELDS, std::ranges::random_access_range PACKETS>
+std::size_t extract(PACKETS const& packets, std::span<typename FIELDS::value_type>... outs)
+{
+	using layout = fixed_layout<MSG>;
+	static_assert((layout::template has<FIELDS> && ...), "FIELDS OF FIXED LAYOUT ARE EXPECTED");
+	constexpr std::size_t need = std::max({(layout::template offset<FIELDS> + layout::template width<FIELDS>)...});
+
+	auto const first = std::ranges::begin(packets);
+	std::size_t num = std::min({std::size_t(std::ranges::size(packets)), outs.size()...});
+	for (std::size_t i = 0; i < num; ++i)
+	{
+		if (std::ranges::size(first[i]) < need) { num = i; break; }
+	}
+
+	([&]
+	{
+		constexpr auto OFS = layout::template offset<FIELDS>;
+		constexpr auto NUM_BYTES = layout::template width<FIELDS>;
+		for (std::size_t i = 0; i < num; ++i)
+		{
+			outs[i] = load_bytes<NUM_BYTES, typename FIELDS::value_type>(std::ranges::data(first[i]) + OFS);
+		}
+	}(), ...);
+	return num;
+}
+
+}	//end: namespace med
@@ -38,16 +38,17 @@ public:
 
 	uint8_t const* data() const { return inplace() && is_set() ? m_data.internal : m_data.external; }
 
-	std::size_t uint() const
+	//sink is optional buffer or context to report the error into
+	std::size_t uint(auto&... sink) const requires (sizeof...(sink) <= 1)
 	{
-		if (not inplace()) { throw invalid_value("too many bits", std::size_t(num_of_bits())); }
+		if (not inplace()) { MED_THROW_EXCEPTION(invalid_value, "too many bits", std::size_t(num_of_bits()), sink...) }
 		std::size_t v = m_data.internal[0];
 		for (std::size_t n = 1; n < size(); ++n) { v = (v << 8) | m_data.internal[n]; }
 		return v >> (8 - m_least_bits);
 	}
-	void uint(nbits num_bits, std::size_t v)
+	void uint(nbits num_bits, std::size_t v, auto&... sink)
 	{
-		set_nums<sizeof(m_data.internal)>(num_bits);
+		if (not set_nums<sizeof(m_data.internal)>(num_bits, sink...)) { return; }
 		v <<= 8 - m_least_bits;
 		for (std::size_t n = 0; n < size(); ++n)
 			{ m_data.internal[n] = uint8_t(v >> 8*(size() - n - 1)); }
@@ -57,7 +58,7 @@ public:
 
 	void assign_bits(void const* b, nbits num_bits)
 	{
-		set_nums<std::numeric_limits<decltype(m_num_bytes)>::max()>(num_bits);
+		if (not set_nums<std::numeric_limits<decltype(m_num_bytes)>::max()>(num_bits)) { return; }
 		if (inplace()) { std::memcpy(&m_data.internal, b, m_num_bytes); }
 		else           { m_data.external = static_cast<uint8_t const*>(b); }
 	}
@@ -65,14 +66,16 @@ public:
 private:
 	bool inplace() const        { return m_num_bytes <= sizeof(m_data.internal); }
 
+	//false if too many bits w/o exceptions
 	template <std::size_t MAX>
-	void set_nums(nbits num_bits)
+	bool set_nums(nbits num_bits, auto&... sink)
 	{
 		auto const num_bytes = bits_to_bytes(std::size_t(num_bits));
-		if (num_bytes > MAX) { throw invalid_value("number of bits", std::size_t(num_bits)); }
+		if (num_bytes > MAX) { MED_THROW_EXCEPTION(invalid_value, "number of bits", std::size_t(num_bits), sink...) }
 
 		m_num_bytes = static_cast<decltype(m_num_bytes)>(num_bytes);
 		m_least_bits = calc_least_bits(std::size_t(num_bits));
+		return true;
 	}
 
 	uint16_t    m_num_bytes {0};
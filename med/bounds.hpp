@@ -0,0 +1,224 @@
+/**
+@file
+compile-time bounds of encoded size and allocations of message
+
+@copyright Denis Priyomov 2016-2017
+Distributed under the MIT License
+(See accompanying file LICENSE or visit https://github.com/cppden/med)
+*/
+
+#pragma once
+
+#include <algorithm>
+
+#include "concepts.hpp"
+#include "field.hpp"
+#include "ie_type.hpp"
+#include "padding.hpp"
+#include "units.hpp"
+#include "value_traits.hpp"
+#include "sl/octet_info.hpp"
+#include "meta/typelist.hpp"
+
+namespace med {
+
+namespace detail {
+
+template <class CODEC, class IE> constexpr std::size_t max_ie_size();
+
+//tags and lengths of meta-info
+template <class META_INFO>
+constexpr std::size_t max_meta_size()
+{
+	if constexpr (meta::list_is_empty_v<META_INFO>)
+	{
+		return 0;
+	}
+	else
+	{
+		using mi = meta::list_first_t<META_INFO>;
+		using info_t = get_info_t<mi>;
+		std::size_t size = bits_to_bytes(info_t::traits::bits);
+		if constexpr (mi::kind == mik::LEN)
+		{
+			using pad_traits = typename get_padding<info_t>::type;
+			if constexpr (!std::is_void_v<pad_traits>) { size += bits_to_bytes(pad_traits::pad_bits) - 1; }
+		}
+		return size + max_meta_size<meta::list_rest_t<META_INFO>>();
+	}
+}
+
+//value of field w/o its meta-info
+template <class CODEC, class FIELD>
+constexpr std::size_t max_field_size()
+{
+	using ie_type = typename FIELD::ie_type;
+	if constexpr (ACold<FIELD>)
+	{
+		return max_field_size<CODEC, typename FIELD::cold_type>();
+	}
+	else if constexpr (std::is_same_v<IE_NULL, ie_type>)
+	{
+		return 0;
+	}
+	else if constexpr (std::is_same_v<IE_VALUE, ie_type>)
+	{
+		return bits_to_bytes(FIELD::traits::bits);
+	}
+	else if constexpr (std::is_same_v<IE_OCTET_STRING, ie_type>)
+	{
+		static_assert(FIELD::traits::max_octets != inf::value, "UNBOUNDED OCTET STRING (SEE max<N>)");
+		return FIELD::traits::max_octets;
+	}
+	else if constexpr (std::is_same_v<IE_BIT_STRING, ie_type>)
+	{
+		return bits_to_bytes(FIELD::traits::max_bits);
+	}
+	else if constexpr (std::is_same_v<IE_CHOICE, ie_type>)
+	{
+		//the tag of alternative is encoded in the compound header
+		constexpr std::size_t header = [] {
+			if constexpr (FIELD::plain_header) { return 0; }
+			else { return max_ie_size<CODEC, typename FIELD::header_type>(); }
+		}();
+		return header + []<class... IEs>(meta::typelist<IEs...>*)
+		{
+			return std::max({std::size_t(0), [] {
+				if constexpr (FIELD::plain_header) { return max_ie_size<CODEC, IEs>(); }
+				else
+				{
+					using mi = meta::list_rest_t<meta::produce_info_t<CODEC, IEs>>;
+					return max_meta_size<mi>() + max_field_size<CODEC, get_field_type_t<IEs>>();
+				}
+			}()...});
+		}(static_cast<typename FIELD::ies_types*>(nullptr));
+	}
+	else
+	{
+		return []<class... IEs>(meta::typelist<IEs...>*)
+		{
+			return (std::size_t(0) + ... + max_ie_size<CODEC, IEs>());
+		}(static_cast<typename FIELD::ies_types*>(nullptr));
+	}
+}
+
+//IE with its meta-info and all instances
+template <class CODEC, class IE>
+constexpr std::size_t max_ie_size()
+{
+	using mi = meta::produce_info_t<CODEC, IE>;
+	if constexpr (AMultiField<IE>)
+	{
+		static_assert(IE::max != inf::value, "UNBOUNDED MULTI-FIELD (SEE max<N>)");
+		std::size_t counter = 0;
+		if constexpr (ACounter<IE>) { counter = max_ie_size<CODEC, typename IE::counter_type>(); }
+		return counter + IE::max * (max_meta_size<mi>() + max_field_size<CODEC, get_field_type_t<IE>>());
+	}
+	else
+	{
+		return max_meta_size<mi>() + max_field_size<CODEC, get_field_type_t<IE>>();
+	}
+}
+
+template <class IE> constexpr std::size_t max_ie_arena();
+
+//allocations of field w/o the ones of multi-field itself
+template <class FIELD>
+constexpr std::size_t max_field_arena()
+{
+	using ie_type = typename FIELD::ie_type;
+	if constexpr (ACold<FIELD>)
+	{
+		//allocated once present (see cold)
+		using cold_type = typename FIELD::cold_type;
+		return sizeof(cold_type) + alignof(cold_type) - 1 + max_field_arena<cold_type>();
+	}
+	else if constexpr (std::is_same_v<IE_CHOICE, ie_type>)
+	{
+		constexpr std::size_t header = [] {
+			if constexpr (FIELD::plain_header) { return 0; }
+			else { return max_ie_arena<typename FIELD::header_type>(); }
+		}();
+		return header + []<class... IEs>(meta::typelist<IEs...>*)
+		{
+			return std::max({std::size_t(0), max_ie_arena<IEs>()...});
+		}(static_cast<typename FIELD::ies_types*>(nullptr));
+	}
+	else if constexpr (std::is_base_of_v<CONTAINER, ie_type>)
+	{
+		return []<class... IEs>(meta::typelist<IEs...>*)
+		{
+			return (std::size_t(0) + ... + max_ie_arena<IEs>());
+		}(static_cast<typename FIELD::ies_types*>(nullptr));
+	}
+	else
+	{
+		return 0;
+	}
+}
+
+//allocations of instances beyond inplace ones (incl. alignment)
+template <class IE>
+constexpr std::size_t max_ie_arena()
+{
+	if constexpr (AMultiField<IE>)
+	{
+		static_assert(IE::max != inf::value, "UNBOUNDED MULTI-FIELD (SEE max<N>)");
+		using field_type = typename IE::field_type;
+		using field_value = typename IE::field_value;
+		std::size_t size = 0;
+		if constexpr (std::is_same_v<field_type, field_value>)
+		{
+			//stored as is so grown twice by new block each time (see multi_vector)
+			for (std::size_t num = IE::inplace; num < IE::max; )
+			{
+				num = std::max(num + 1, std::min(2 * num, IE::max));
+				size += num * sizeof(field_value) + alignof(field_value) - 1;
+			}
+		}
+		else
+		{
+			//node per instance (see multi_list)
+			size = (IE::max - IE::inplace) * (sizeof(field_value) + alignof(field_value) - 1);
+		}
+		return size + IE::max * max_field_arena<field_type>();
+	}
+	else
+	{
+		return max_field_arena<get_field_type_t<IE>>();
+	}
+}
+
+} //end: namespace detail
+
+/**
+ * Upper bound of the encoded size of message to size the buffers statically.
+ * Each IE is counted with its tags and lengths at its maximum: octet strings
+ * by max octets, multi-fields by max arity and choice by the largest case.
+ * NOTE: unbounded octet strings and multi-fields are rejected at compile-time
+ * @tparam MSG message to encode
+ * @tparam CODEC octet codec to produce meta-info of IEs (tags and lengths)
+ * @return number of octets
+ */
+template <class MSG, class CODEC = sl::octet_info>
+constexpr std::size_t max_encoded_size()
+{
+	static_assert(std::is_base_of_v<sl::octet_info, CODEC>, "OCTET CODEC IS EXPECTED");
+	return detail::max_ie_size<CODEC, MSG>();
+}
+
+/**
+ * Upper bound of the allocator space used to decode message (see allocator).
+ * Each allocation is counted at its worst alignment and multi-fields by the
+ * instances beyond the inplace ones up to max arity.
+ * NOTE: unbounded multi-fields are rejected at compile-time
+ * @tparam MSG message to decode
+ * @return number of octets
+ */
+template <class MSG>
+constexpr std::size_t max_arena_bytes()
+{
+	return detail::max_ie_arena<MSG>();
+}
+
+}	//end: namespace med
@@ -103,7 +103,7 @@ public:
 		bool        m_commited{ false };
 	};
 
-	constexpr auto push_size(std::size_t size, bool commit_)
+	constexpr size_state push_size(std::size_t size, bool commit_)
 	{
 		if (auto* pend = begin() + size; pend <= end()) //within the current end of buffer
 		{
@@ -126,15 +126,16 @@ public:
 		}
 		else
 		{
-			MED_THROW_EXCEPTION(overflow, "end of buffer", pend - end());
+			MED_THROW_EXCEPTION(overflow, "end of buffer", size, *this)
 		}
 	}
 
-	constexpr void reset() noexcept                  { m_state.reset(get_start()); }
+	constexpr void reset() noexcept                  { m_state.reset(get_start()); m_error.reset(); }
 	constexpr void reset(void const* p, std::size_t s) noexcept
 	{
 		m_start = static_cast<pointer>(const_cast<void*>(p));
 		m_state.reset(m_start);
+		m_error.reset();
 		end(m_start + s);
 	}
 	template <typename U> requires (std::is_integral_v<U>)
@@ -176,9 +177,9 @@ public:
 	constexpr bool empty() const noexcept                   { return begin() >= end(); }
 	explicit constexpr operator bool() const noexcept       { return !empty(); }
 
-	template <class IE> constexpr void push(value_type v) requires (!is_const_v)
+	template <class IE> constexpr MED_RESULT push(value_type v) requires (!is_const_v)
 	{
-		if (not empty()) { *m_state.cursor++ = v; }
+		if (not empty()) { *m_state.cursor++ = v; MED_RETURN_SUCCESS; }
 		else { MED_THROW_EXCEPTION(overflow, name<IE>(), sizeof(value_type), *this) }
 	}
 
@@ -225,15 +226,38 @@ public:
 		return p;
 	}
 
+	/// advances forward by the number of units given in input (e.g. length)
+	template <class IE> constexpr MED_RESULT skip(std::size_t num)
+	{
+		if (size() < num) { MED_THROW_EXCEPTION(overflow, name<IE>(), num, *this) }
+		m_state.cursor += num;
+		MED_RETURN_SUCCESS;
+	}
+
 	/// similar to advance but no bounds check
 	constexpr void offset(int delta) noexcept               { m_state.cursor += delta; }
 
-	template <class IE> constexpr void fill(std::size_t count, uint8_t value) requires (!is_const_v)
+	/// checks the space once for several advance_unchecked
+	template <class IE> constexpr MED_RESULT require(std::size_t num)
+	{
+		if (size() < num) { MED_THROW_EXCEPTION(overflow, name<IE>(), num, *this) }
+		MED_RETURN_SUCCESS;
+	}
+	/// similar to advance_bits but no bounds check (see require)
+	template <size_t BITS> constexpr pointer advance_unchecked() noexcept
+	{
+		auto p = begin();
+		m_state.cursor += BITS / 8;
+		return p;
+	}
+
+	template <class IE> constexpr MED_RESULT fill(std::size_t count, uint8_t value) requires (!is_const_v)
 	{
 		//CODEC_TRACE("padding %zu bytes=%u", count, value);
 		if (size() >= count)
 		{
 			while (count--) *m_state.cursor++ = value;
+			MED_RETURN_SUCCESS;
 		}
 		else
 		{
@@ -269,6 +293,10 @@ public:
 		return out << buf.toString();
 	}
 
+	//the 1st error occurred when exceptions are disabled (see MED_NO_EXCEPTION)
+	constexpr error_context& error_ctx() noexcept             { return m_error; }
+	constexpr error_context const& error_ctx() const noexcept { return m_error; }
+
 private:
 	friend class size_state;
 
@@ -314,6 +342,7 @@ private:
 	state_type     m_store{};
 	uint8_t        m_eob_index {0};
 	pointer        m_eob[LEN_DEPTH]{};
+	error_context  m_error{};
 };
 
 }	//end: namespace med
@@ -14,6 +14,7 @@ Distributed under the MIT License
 #include "exception.hpp"
 #include "accessor.hpp"
 #include "tag.hpp"
+#include "tag_dispatch.hpp"
 #include "length.hpp"
 #include "value.hpp"
 #include "encode.hpp"
@@ -151,7 +152,7 @@ struct choice_name
 struct choice_enc : choice_if
 {
 	template <class IE, class TO, class ENCODER>
-	static constexpr void apply(TO const& to, ENCODER& encoder)
+	static constexpr MED_RESULT apply(TO const& to, ENCODER& encoder)
 	{
 		using mi = meta::produce_info_t<ENCODER, IE>;
 		CODEC_TRACE("%s CASE[%s] mi=%s", TO::plain_header?"plain":"compound", name<IE>(), class_name<mi>());
@@ -163,14 +164,19 @@ struct choice_enc : choice_if
 				if constexpr(std::is_same_v<EXP_TAG, get_field_type_t<meta::list_first_t<typename IE::ies_types>>>)
 				{
 					CODEC_TRACE("explicit[%s] mi=%s", name<EXP_TAG>(), class_name<mi>());
-					//encoode 1st TAG meta-info via exposed
-					sl::ie_encode<type_context<IE_CHOICE>>(encoder, to.template as<EXP_TAG>());
 					//skip 1st TAG meta-info and encode it via exposed
 					using ctx = type_context<IE_CHOICE, meta::list_rest_t<mi>, EXP_TAG>;
+					if constexpr (sl::AReverseEncoder<ENCODER>)
+					{
+						MED_CHECK_FAIL(sl::ie_encode<ctx>(encoder, to.template as<IE>()));
+						return sl::ie_encode<type_context<IE_CHOICE>>(encoder, to.template as<EXP_TAG>());
+					}
+					//encoode 1st TAG meta-info via exposed
+					MED_CHECK_FAIL(sl::ie_encode<type_context<IE_CHOICE>>(encoder, to.template as<EXP_TAG>()));
 					return sl::ie_encode<ctx>(encoder, to.template as<IE>());
 				}
 			}
-			med::encode(encoder, to.template as<IE>());
+			return med::encode(encoder, to.template as<IE>());
 		}
 		else
 		{
@@ -182,16 +188,22 @@ struct choice_enc : choice_if
 				//TODO: how to not modify?
 				const_cast<TO&>(to).header().set_tag(tag.get());
 			}
-			med::encode(encoder, to.header());
 			//skip 1st TAG meta-info as it's encoded in header
-			sl::ie_encode<type_context<IE_CHOICE, meta::list_rest_t<mi>>>(encoder, to.template as<IE>());
+			using ctx = type_context<IE_CHOICE, meta::list_rest_t<mi>>;
+			if constexpr (sl::AReverseEncoder<ENCODER>)
+			{
+				MED_CHECK_FAIL(sl::ie_encode<ctx>(encoder, to.template as<IE>()));
+				return med::encode(encoder, to.header());
+			}
+			MED_CHECK_FAIL(med::encode(encoder, to.header()));
+			return sl::ie_encode<ctx>(encoder, to.template as<IE>());
 		}
 	}
 
 	template <class TO, class ENCODER>
-	static constexpr void apply(TO const& to, ENCODER&)
+	static constexpr MED_RESULT apply(TO const& to, ENCODER& encoder)
 	{
-		MED_THROW_EXCEPTION(unknown_tag, name<TO>(), to.index())
+		MED_THROW_EXCEPTION(unknown_tag, name<TO>(), to.index(), encoder)
 	}
 };
 
@@ -208,8 +220,13 @@ struct choice_dec
 	}
 
 	template <class IE, class TO, class HEADER, class DECODER, class... DEPS>
-	static constexpr void apply(TO& to, HEADER const& header, DECODER& decoder, DEPS&... deps)
+	static constexpr MED_RESULT apply(TO& to, HEADER const& header, DECODER& decoder, DEPS&... deps)
 	{
+		if constexpr (is_selected_v<DECODER, IE>)
+		{
+			//decoded completely by the original decoder
+			return apply<IE>(to, header, decoder.base(), deps...);
+		}
 		CODEC_TRACE("CASE[%s] %s", name<IE>(), class_name<IE>());
 		auto& ie = static_cast<IE&>(to.template ref<get_field_type_t<IE>>());
 		//skip 1st TAG meta-info as it's decoded in header
@@ -226,13 +243,13 @@ struct choice_dec
 				return sl::ie_decode<type_context<IE_CHOICE, meta::list_rest_t<mi>, EXP_TAG>>(decoder, ie, deps...);
 			}
 		}
-		sl::ie_decode<type_context<IE_CHOICE, meta::list_rest_t<mi>>>(decoder, ie, deps...);
+		return sl::ie_decode<type_context<IE_CHOICE, meta::list_rest_t<mi>>>(decoder, ie, deps...);
 	}
 
 	template <class TO, class HEADER, class DECODER, class... DEPS>
-	constexpr void apply(TO&, HEADER const& header, DECODER&, DEPS&...)
+	constexpr MED_RESULT apply(TO&, HEADER const& header, DECODER& decoder, DEPS&...)
 	{
-		MED_THROW_EXCEPTION(unknown_tag, name<TO>(), get_tag(header))
+		MED_THROW_EXCEPTION(unknown_tag, name<TO>(), get_tag(header), decoder)
 	}
 };
 
@@ -344,11 +361,11 @@ public:
 	{ meta::for_if<ies_types>(sl::choice_copy{}, *this, to, std::forward<ARGS>(args)...); }
 
 	template <class ENCODER>
-	constexpr void encode(ENCODER& encoder) const
-	{ meta::for_if<ies_types>(sl::choice_enc{}, *this, encoder); }
+	constexpr MED_RESULT encode(ENCODER& encoder) const
+	{ return meta::for_if<ies_types>(sl::choice_enc{}, *this, encoder); }
 
 	template <class DECODER, class... DEPS>
-	constexpr void decode(DECODER& decoder, DEPS&... deps)
+	constexpr MED_RESULT decode(DECODER& decoder, DEPS&... deps)
 	{
 		static_assert(std::is_void_v<meta::unique_t<tag_getter<DECODER>, ies_types>>
 			, "SEE ERROR ON INCOMPLETE TYPE/UNDEFINED TEMPLATE HOLDING IEs WITH CLASHED TAGS");
@@ -362,13 +379,14 @@ public:
 			CODEC_TRACE("%s CHOICE WITH PLAIN HEADER, mi=%s tag=%s", name<ies_types>(), name<mi>(), name<tag_t>());
 			as_writable_t<tag_t> tag;
 			tag.set_encoded(sl::decode_tag<tag_t>(decoder));
-			meta::for_if<ies_types>(sl::choice_dec{}, *this, tag, decoder, deps...);
+			MED_RETURN_ON_ERROR(decoder);
+			return tag_dispatch<DECODER, ies_types>(get_tag(tag), sl::choice_dec{}, *this, tag, decoder, deps...);
 		}
 		else
 		{
 			CODEC_TRACE("%s CHOICE W/O PLAIN HEADER", name<ies_types>());
-			med::decode(decoder, this->header(), deps...);
-			meta::for_if<ies_types>(sl::choice_dec{}, *this, this->header(), decoder, deps...);
+			MED_CHECK_FAIL(med::decode(decoder, this->header(), deps...));
+			return tag_dispatch<DECODER, ies_types>(get_tag(this->header()), sl::choice_dec{}, *this, this->header(), decoder, deps...);
 		}
 	}
 
@@ -0,0 +1,143 @@
+/**
+@file
+IE stored out of message until present
+
+@copyright Denis Priyomov 2016-2017
+Distributed under the MIT License
+(See accompanying file LICENSE or visit https://github.com/cppden/med)
+*/
+
+#pragma once
+
+#include "allocator.hpp"
+#include "concepts.hpp"
+#include "link.hpp"
+#include "name.hpp"
+#include "traits.hpp"
+#include "meta/typelist.hpp"
+
+namespace med {
+
+/**
+ * Wrapper to keep rarely present IE (e.g. vendor-specific or extension) out of
+ * the message: only the link takes the place of IE in container while the IE
+ * is allocated from the allocator of context when decoded or set.
+ * Typical use is optional IE like O<T, L, cold<IE>>.
+ * NOTE: clear keeps the IE allocated to be reused when set again so reset the
+ *       message (see container::reset) before its allocator is released.
+ * @tparam FIELD the IE wrapped
+ */
+template <AField FIELD>
+class cold
+{
+public:
+	using cold_type = FIELD;
+	using ie_type = typename FIELD::ie_type;
+	using meta_info = get_meta_info_t<FIELD>;
+
+	static constexpr char const* name()         { return med::name<FIELD>(); }
+
+	cold() = default;
+	cold(cold const&) = delete;
+	cold& operator= (cold const&) = delete;
+
+	bool is_set() const                         { return m_field && m_field->is_set(); }
+	//keeps the IE allocated for reuse
+	void clear()                                { if (m_field) { m_field->clear(); } }
+	//drops the IE allocated (e.g. to release the allocator)
+	void reset()                                { m_field = nullptr; }
+
+	//IE or nullptr if not set
+	FIELD const* get() const                    { return is_set() ? m_field.get() : nullptr; }
+
+	//IE allocated already (e.g. by decode or before clear) or nullptr
+	FIELD* emplace()                            { return m_field; }
+
+	/**
+	 * Allocates IE unless allocated already (incl. the one kept by clear)
+	 * @param ctx context with allocator and to report the error
+	 * @return IE or nullptr/throw when out of space
+	 */
+	template <class CTX> FIELD* emplace(CTX& ctx)
+	{
+		if (!m_field)
+		{
+			auto* p = create<FIELD>(get_allocator(ctx));
+			//allocation out of link range is unusable (see MED_LINK_OFFSET)
+			if (!p || !m_field.reaches(p)) { MED_THROW_EXCEPTION(out_of_memory, name(), sizeof(FIELD), ctx) }
+			m_field = p;
+		}
+		return m_field;
+	}
+
+	/**
+	 * Copies the IE into the one allocated already or allocated from context
+	 * @param args optional allocator or context: out_of_memory w/o it unless
+	 *        the IE is allocated already (e.g. kept by clear)
+	 */
+	template <class... ARGS>
+	void copy(cold const& from, ARGS&&... args)
+	{
+		if (auto const* p = from.get())
+		{
+			if (auto* to = copy_target(args...)) { to->copy(*p, std::forward<ARGS>(args)...); }
+		}
+		else
+		{
+			clear();
+		}
+	}
+
+	//takes over the IE of other leaving it w/o one
+	template <class... ARGS>
+	void move_from(cold& from, ARGS&&...)
+	{
+		m_field = from.m_field;
+		from.reset();
+	}
+
+	bool operator==(cold const& rhs) const
+	{
+		auto const *lhs_ie = get(), *rhs_ie = rhs.get();
+		return (lhs_ie && rhs_ie) ? *lhs_ie == *rhs_ie : lhs_ie == rhs_ie;
+	}
+
+private:
+	template <class... CTX> FIELD* copy_target(CTX&... ctx)
+	{
+		if constexpr (requires { get_allocator(ctx...); })
+		{
+			return emplace(ctx...);
+		}
+		else
+		{
+			if (!m_field) { MED_THROW_EXCEPTION(out_of_memory, name(), sizeof(FIELD), ctx...) }
+			return m_field;
+		}
+	}
+
+	link<FIELD> m_field;
+};
+
+//field is cold or has cold IEs inside to be reset (see container::reset)
+template <class FIELD>
+constexpr bool has_cold()
+{
+	if constexpr (ACold<FIELD>)
+	{
+		return true;
+	}
+	else if constexpr (requires { typename FIELD::ies_types; })
+	{
+		return []<class... IEs>(meta::typelist<IEs...>*)
+		{
+			return (false || ... || has_cold<get_field_type_t<IEs>>());
+		}(static_cast<typename FIELD::ies_types*>(nullptr));
+	}
+	else
+	{
+		return false;
+	}
+}
+
+}	//end: namespace med
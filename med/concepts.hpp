@@ -176,6 +176,13 @@ concept AEmptyTypeList = meta::list_is_empty_v<L>;
 
 template <class T> concept APredefinedValue = (T::is_defined == true);
 
+//field stored out of container (see cold)
+template <class T>
+concept ACold = requires(T v)
+{
+	typename T::cold_type;
+};
+
 template <class T>
 concept AHasMetaInfo = !AEmptyTypeList<typename T::meta_info>;
 
@@ -9,6 +9,22 @@ Distributed under the MIT License
 
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
+
 //#ifndef CODEC_TRACE_ENABLE
 //#endif
 
+//signed integer to store offsets of links (see link.hpp): the default halves
+//the links but needs message and its allocations within +/-2GB (e.g. both on
+//stack or in the same arena), std::ptrdiff_t allows any placement
+#ifndef MED_LINK_OFFSET
+#define MED_LINK_OFFSET int32_t
+#endif
+
+//signed integer to store offsets of links to external octet strings: the data
+//decoded from (e.g. receive buffer or mapped file) or set from (e.g. literal)
+//is rarely near the message so the default allows any placement
+#ifndef MED_EXTERN_LINK_OFFSET
+#define MED_EXTERN_LINK_OFFSET std::ptrdiff_t
+#endif
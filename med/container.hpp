@@ -13,6 +13,8 @@ Distributed under the MIT License
 #include "accessor.hpp"
 #include "length.hpp"
 #include "concepts.hpp"
+#include "cold.hpp"
+#include "presence.hpp"
 #include "sl/field_copy.hpp"
 #include "meta/typelist.hpp"
 #include "meta/foreach.hpp"
@@ -27,6 +29,17 @@ struct cont_clear
 	static void apply(SEQ& s)           { static_cast<IE&>(s).clear(); }
 };
 
+struct cont_reset
+{
+	template <class IE, class SEQ>
+	static void apply(SEQ& s)
+	{
+		//NOTE: choice re-creates its case once cleared so has nothing kept
+		if constexpr (has_cold<get_field_type_t<IE>>() && requires(IE& ie) { ie.reset(); }) { static_cast<IE&>(s).reset(); }
+		else { static_cast<IE&>(s).clear(); }
+	}
+};
+
 struct cont_copy
 {
 	template <class IE, class TO, class FROM, class... ARGS>
@@ -43,6 +56,7 @@ struct cont_copy
 				for (auto const& rhs : from_field)
 				{
 					auto* p = to_field.push_back(std::forward<ARGS>(args)...);
+					if (!p) { return; } //out of memory w/o exceptions
 					p->copy(rhs, std::forward<ARGS>(args)...);
 				}
 			}
@@ -54,6 +68,45 @@ struct cont_copy
 	}
 };
 
+struct cont_move
+{
+	template <class IE, class TO, class FROM, class... ARGS>
+	static void apply(TO& to, FROM& from, ARGS&&... args)
+	{
+		using field_t = get_field_type_t<IE>;
+		auto& from_field = from.m_ies.template as<field_t>();
+		if (from_field.is_set())
+		{
+			auto& to_field = to.m_ies.template as<field_t>();
+			if constexpr (requires { to_field.splice(from_field, args...); })
+			{
+				to_field.splice(from_field, std::forward<ARGS>(args)...);
+			}
+			else if constexpr (AMultiField<IE>)
+			{
+				//different storage: by instance
+				to_field.clear();
+				for (auto& rhs : from_field)
+				{
+					auto* p = to_field.push_back(std::forward<ARGS>(args)...);
+					if (!p) { return; } //out of memory w/o exceptions
+					if constexpr (requires { p->move_from(rhs, args...); }) { p->move_from(rhs, std::forward<ARGS>(args)...); }
+					else { p->copy(rhs, std::forward<ARGS>(args)...); }
+				}
+				from_field.clear();
+			}
+			else if constexpr (requires { to_field.move_from(from_field, args...); })
+			{
+				to_field.move_from(from_field, std::forward<ARGS>(args)...);
+			}
+			else
+			{
+				to_field.copy(from_field, std::forward<ARGS>(args)...);
+			}
+		}
+	}
+};
+
 template <class TYPE_CTX>
 struct cont_len
 {
@@ -167,20 +220,27 @@ constexpr std::size_t field_arity()
 template <class IE_TYPE, class... IES>
 class container : public IE<IE_TYPE>
 {
+protected:
+	using split = detail::split_generation<IES...>;
+	struct fields_t;
+	using layout = detail::presence_layout<fields_t, typename split::ies_types>;
+
 public:
 	using container_t = container<IE_TYPE, IES...>;
-	using ies_types = meta::typelist<IES...>;
+	//packed values are replaced to keep presence in container (see packed)
+	using ies_types = typename layout::type;
 
 	template <class T>
 	static constexpr bool has()             { return not std::is_void_v<meta::find_t<ies_types, sl::field_at<T>>>; }
 
+	//NOTE: packed value is returned as is to set its presence in container
 	template <class FIELD>
 	decltype(auto) ref()
 	{
 		static_assert(!std::is_const_v<FIELD>, "ATTEMPT TO COPY FROM CONST REF");
 		auto& ie = m_ies.template as<FIELD>();
 		using IE = std::remove_cvref_t<decltype(ie)>;
-		if constexpr (AMultiField<IE>)
+		if constexpr (AMultiField<IE> || APackedValue<IE>)
 		{
 			return static_cast<IE&>(ie);
 		}
@@ -205,8 +265,31 @@ public:
 
 	template <class FIELD>
 	void clear()                            { m_ies.template as<FIELD>().clear(); }
-	void clear()                            { meta::foreach<ies_types>(sl::cont_clear{}, this->m_ies); }
-	bool is_set() const                     { return meta::fold<ies_types>(sl::cont_is{}, this->m_ies); }
+	//NOTE: just the next generation w/ generation opted-in (see generation)
+	void clear()
+	{
+		if constexpr (generational)
+		{
+			m_ies.next_generation();
+		}
+		else
+		{
+			m_ies.m_presence.reset();
+			meta::foreach<unpacked_types>(sl::cont_clear{}, this->m_ies);
+		}
+	}
+	//clears and drops the cold IEs kept allocated (see cold) to release the allocator
+	void reset()
+	{
+		auto& fields = m_ies.fields();
+		fields.m_presence.reset();
+		meta::foreach<unpacked_types>(sl::cont_reset{}, fields);
+		if constexpr (generational) { m_ies.sync(); }
+	}
+	bool is_set() const
+	{
+		return m_ies.fields().m_presence.any() || meta::fold<unpacked_types>(sl::cont_is{}, this->m_ies);
+	}
 	template <class IE_LIST, class TYPE_CTX>
 	std::size_t calc_length(auto& enc) const { return meta::fold<IE_LIST>(sl::cont_len<TYPE_CTX>{}, this->m_ies, enc); }
 	template <class TYPE_CTX = type_context<IE_TYPE>>
@@ -220,13 +303,41 @@ public:
 	void copy_to(TO& to, ARGS&&... args) const
 	{ meta::foreach<ies_types>(sl::cont_copy{}, to, *this, std::forward<ARGS>(args)...); }
 
+	/**
+	 * Transfers the fields from other message which is discarded after that
+	 * (e.g. request forwarded by proxy): the instances of multi-fields in
+	 * external storage and cold IEs are relinked w/o copy or allocation while
+	 * the rest is copied as by copy (external octet strings by reference).
+	 * @param from message to transfer from, left w/o multi-fields and cold IEs
+	 * @param args optional allocator or context to copy with if needed
+	 * NOTE: the storage of from (e.g. arena) is to outlive this message
+	 */
+	template <class FROM, class... ARGS>
+	void move_from(FROM& from, ARGS&&... args)
+	{ meta::foreach<ies_types>(sl::cont_move{}, *this, from, std::forward<ARGS>(args)...); }
+
 	bool operator==(container const& rhs) const { return meta::fold<ies_types>(sl::cont_eq{}, this->m_ies, rhs.m_ies); }
 
 protected:
 	friend struct sl::cont_copy;
+	friend struct sl::cont_move;
 
-	struct ies_t : IES...
+	using unpacked_types = meta::remove_if_t<ies_types, sl::is_packed_ie>;
+	static constexpr bool generational = !std::is_void_v<typename split::counter_type>;
+
+	struct fields_t : detail::inherit_list<ies_types>
 	{
+		//presence of packed values
+		[[no_unique_address]] detail::presence_bits<layout::num_bits> m_presence;
+	};
+
+	struct plain_ies : fields_t
+	{
+		using ies_types = container::ies_types;
+
+		fields_t& fields() noexcept             { return *this; }
+		fields_t const& fields() const noexcept { return *this; }
+
 		template <class FIELD>
 		decltype(auto) as() const
 		{
@@ -244,6 +355,12 @@ protected:
 		}
 	};
 
+	struct ies_t : conditional_t<generational
+		, detail::generation_ies<fields_t, typename split::counter_type, ies_types>
+		, plain_ies>
+	{
+	};
+
 	ies_t m_ies;
 };
 
@@ -16,6 +16,7 @@ Distributed under the MIT License
 #include "concepts.hpp"
 #include "name.hpp"
 #include "exception.hpp"
+#include "select.hpp"
 
 namespace med {
 
@@ -29,18 +30,19 @@ struct counter_t
 namespace detail {
 
 template <class FUNC, class IE>
-constexpr void check_n_arity(FUNC&, IE const&, std::size_t count)
+constexpr MED_RESULT check_n_arity(FUNC& func, IE const&, std::size_t count)
 {
 	if (count >= IE::min)
 	{
 		if (count > IE::max)
 		{
-			MED_THROW_EXCEPTION(extra_ie, name<IE>(), IE::max, count)
+			MED_THROW_EXCEPTION(extra_ie, name<IE>(), IE::max, count, func)
 		}
+		MED_RETURN_SUCCESS;
 	}
 	else
 	{
-		MED_THROW_EXCEPTION(missing_ie, name<IE>(), IE::min, count)
+		MED_THROW_EXCEPTION(missing_ie, name<IE>(), IE::min, count, func)
 	}
 }
 
@@ -48,22 +50,25 @@ constexpr void check_n_arity(FUNC&, IE const&, std::size_t count)
 
 //multi-field
 template <class FUNC, class IE>
-constexpr void check_arity(FUNC& func, IE const& ie, std::size_t count)
+constexpr MED_RESULT check_arity(FUNC& func, IE const& ie, std::size_t count)
 {
 	if constexpr (AOptional<IE>)
 	{
-		if (count) { detail::check_n_arity(func, ie, count); }
+		if (count) { return detail::check_n_arity(func, ie, count); }
+		MED_RETURN_SUCCESS;
 	}
 	else
 	{
-		detail::check_n_arity(func, ie, count);
+		return detail::check_n_arity(func, ie, count);
 	}
 }
 
 template <class FUNC, class IE>
-constexpr void check_arity(FUNC& func, IE const& ie)
+constexpr MED_RESULT check_arity(FUNC& func, IE const& ie)
 {
-	check_arity(func, ie, ie.count());
+	//no instances are stored when skipped
+	if constexpr (is_skipped_v<FUNC, IE>) { MED_RETURN_SUCCESS; }
+	else { return check_arity(func, ie, ie.count()); }
 }
 
 
@@ -18,6 +18,7 @@ Distributed under the MIT License
 #include "length.hpp"
 #include "name.hpp"
 #include "value.hpp"
+#include "select.hpp"
 #include "meta/typelist.hpp"
 
 
@@ -28,11 +29,12 @@ namespace sl {
 
 //Tag
 template <class TAG_TYPE>
-constexpr auto decode_tag(auto& decoder)
+constexpr auto decode_tag(auto& decoder) -> typename as_writable_t<TAG_TYPE>::value_type
 {
 	TAG_TYPE ie;
 	typename as_writable_t<TAG_TYPE>::value_type value{};
 	value = decoder(ie, IE_TAG{});
+	MED_RETURN_ON_ERROR(decoder);
 	CODEC_TRACE("%s=0x%zX(%zu) [%s]", __FUNCTION__, std::size_t(value), std::size_t(value), class_name<TAG_TYPE>());
 	return value;
 }
@@ -41,16 +43,16 @@ template <class LEN_TYPE>
 constexpr std::size_t decode_len(auto& decoder)
 {
 	LEN_TYPE ie;
-	decoder(ie, IE_LEN{});
+	MED_CHECK_FAIL(decoder(ie, IE_LEN{}));
 	return value_to_length(ie);
 }
 
 template <class TYPE_CTX, class DECODER, class IE, class... DEPS>
-constexpr void ie_decode(DECODER& decoder, IE& ie, DEPS&... deps);
+constexpr MED_RESULT ie_decode(DECODER& decoder, IE& ie, DEPS&... deps);
 
 
 template <class LEN_TYPE, class TYPE_CTX, class DECODER, class IE, class... DEPS>
-void apply_len(DECODER& decoder, IE& ie, DEPS&... deps)
+MED_RESULT apply_len(DECODER& decoder, IE& ie, DEPS&... deps)
 {
 	using META_INFO = typename TYPE_CTX::meta_info_type;
 	using EXP_TAG = typename TYPE_CTX::explicit_tag_type;
@@ -69,44 +71,52 @@ void apply_len(DECODER& decoder, IE& ie, DEPS&... deps)
 		{
 			//!!! len is not yet available when explicit
 			auto end = decoder(PUSH_SIZE{0, false});
+			MED_RETURN_ON_ERROR(decoder);
 			if constexpr (std::is_void_v<pad_traits>)
 			{
-				ie_decode<ctx>(decoder, ie, end, deps...);
+				MED_CHECK_FAIL(ie_decode<ctx>(decoder, ie, end, deps...));
 				//TODO: ??? as warning not error
-				if (0 != end.size()) { MED_THROW_EXCEPTION(overflow, name<IE>(), end.size()); }
+				if (0 != end.size()) { MED_THROW_EXCEPTION(overflow, name<IE>(), end.size(), decoder) }
 			}
 			else
 			{
 				CODEC_TRACE("padded %s...:", name<LEN_TYPE>());
 				using pad_t = typename DECODER::template padder_type<pad_traits, DECODER>;
 				pad_t pad{decoder};
-				ie_decode<ctx>(decoder, ie, end, deps...);
+				MED_CHECK_FAIL(ie_decode<ctx>(decoder, ie, end, deps...));
 				CODEC_TRACE("before padding %s: end=%zu padding=%u", name<LEN_TYPE>(), end.size(), pad.padding_size());
 				//if (end.size() != pad.padding_size()) { MED_THROW_EXCEPTION(overflow, name<IE>(), end.size()); }
 				end.restore_end();
-				pad.add_padding();
+				return pad.add_padding();
 			}
 		}
 		else
 		{
 			auto const len = decode_len<LEN_TYPE>(decoder);
+			MED_RETURN_ON_ERROR(decoder);
+			if constexpr (is_skipped_v<DECODER, IE> && std::is_void_v<pad_traits> && requires { decoder(SKIP_STATE{}, ie); })
+			{
+				CODEC_TRACE("skip %s: %zu", name<IE>(), len);
+				return decoder(SKIP_STATE{std::size_t(len)}, ie);
+			}
 			auto end = decoder(PUSH_SIZE{len});
+			MED_RETURN_ON_ERROR(decoder);
 			if constexpr (std::is_void_v<pad_traits>)
 			{
-				ie_decode<ctx>(decoder, ie, deps...);
+				MED_CHECK_FAIL(ie_decode<ctx>(decoder, ie, deps...));
 				//TODO: ??? as warning not error
-				if (0 != end.size()) { MED_THROW_EXCEPTION(overflow, name<IE>(), end.size()); }
+				if (0 != end.size()) { MED_THROW_EXCEPTION(overflow, name<IE>(), end.size(), decoder) }
 			}
 			else
 			{
 				CODEC_TRACE("padded %s...:", name<LEN_TYPE>());
 				using pad_t = typename DECODER::template padder_type<pad_traits, DECODER>;
 				pad_t pad{decoder};
-				ie_decode<ctx>(decoder, ie, deps...);
+				MED_CHECK_FAIL(ie_decode<ctx>(decoder, ie, deps...));
 				CODEC_TRACE("before padding %s: end=%zu padding=%u", name<LEN_TYPE>(), end.size(), pad.padding_size());
 				//if (end.size() != pad.padding_size()) { MED_THROW_EXCEPTION(overflow, name<IE>(), end.size()); }
 				end.restore_end();
-				pad.add_padding();
+				return pad.add_padding();
 			}
 		}
 	}
@@ -120,39 +130,43 @@ void apply_len(DECODER& decoder, IE& ie, DEPS&... deps)
 		using ctx = type_context<typename TYPE_CTX::ie_type, META_INFO, EXP_TAG, EXP_LEN, DEPENDENT, DEPENDENCY>;
 
 		auto const len = decode_len<LEN_TYPE>(decoder);
+		MED_RETURN_ON_ERROR(decoder);
 		auto end = decoder(PUSH_SIZE{len, false});
+		MED_RETURN_ON_ERROR(decoder);
 		if constexpr (std::is_void_v<pad_traits>)
 		{
-			ie_decode<ctx>(decoder, ie, end, deps...);
+			MED_CHECK_FAIL(ie_decode<ctx>(decoder, ie, end, deps...));
 			//TODO: ??? as warning not error
 			CODEC_TRACE("decoded '%s' depends on '%s'", name<LEN_TYPE>(), name<dependency_t>());
-			if (0 != end.size()) { MED_THROW_EXCEPTION(overflow, name<IE>(), end.size()); }
+			if (0 != end.size()) { MED_THROW_EXCEPTION(overflow, name<IE>(), end.size(), decoder) }
 		}
 		else
 		{
 			CODEC_TRACE("padded %s...:", name<LEN_TYPE>());
 			using pad_t = typename DECODER::template padder_type<pad_traits, DECODER>;
 			pad_t pad{decoder};
-			ie_decode<ctx>(decoder, ie, end, deps...);
+			MED_CHECK_FAIL(ie_decode<ctx>(decoder, ie, end, deps...));
 			CODEC_TRACE("decoded '%s' depends on '%s'", name<LEN_TYPE>(), name<dependency_t>());
 			//if (end.size() != pad.padding_size()) { MED_THROW_EXCEPTION(overflow, name<IE>(), end.size()); }
 			end.restore_end();
-			pad.add_padding();
+			return pad.add_padding();
 		}
 	}
+	MED_RETURN_SUCCESS;
 }
 
-constexpr void explicit_len_commit(auto&, auto&, auto&) {}
+constexpr MED_RESULT explicit_len_commit(auto&, auto&, auto&) { MED_RETURN_SUCCESS; }
 
 template <class IE>
-constexpr void explicit_len_commit(auto& decoder, IE& ie, auto& end, auto start)
+constexpr MED_RESULT explicit_len_commit(auto& decoder, IE& ie, auto& end, auto start)
 {
-	decoder(ie, typename IE::ie_type{});
+	MED_CHECK_FAIL(decoder(ie, typename IE::ie_type{}));
 	auto const after_len = decoder(GET_STATE{});
 	auto const delta = after_len - start;
 	auto len = value_to_length(ie) + delta;
 	CODEC_TRACE("%s<%s>=%zu (delta=%ld)", __FUNCTION__, name<IE>(), len, delta);
 	end.commit(len);
+	MED_RETURN_SUCCESS;
 }
 
 
@@ -163,7 +177,7 @@ constexpr void invoke_dependency(DEPENDENCY const& ie, DEPS& deps)
 }
 
 template <class TYPE_CTX, class DECODER, class IE, class... DEPS>
-constexpr void ie_decode(DECODER& decoder, IE& ie, DEPS&... deps)
+constexpr MED_RESULT ie_decode(DECODER& decoder, IE& ie, DEPS&... deps)
 {
 	using META_INFO = typename TYPE_CTX::meta_info_type;
 	using EXP_TAG = typename TYPE_CTX::explicit_tag_type;
@@ -186,25 +200,33 @@ constexpr void ie_decode(DECODER& decoder, IE& ie, DEPS&... deps)
 				static_assert(sizeof...(deps) == 0);
 				auto const start = decoder(GET_STATE{});
 				CODEC_TRACE("->> explicit len [%s]", name<info_t>());
-				apply_len<info_t, type_context<typename TYPE_CTX::ie_type, mi_rest, EXP_TAG, info_t>>(decoder, ie, start);
+				return apply_len<info_t, type_context<typename TYPE_CTX::ie_type, mi_rest, EXP_TAG, info_t>>(decoder, ie, start);
 			}
 			else
 			{
-				apply_len<info_t, type_context<typename TYPE_CTX::ie_type, mi_rest, EXP_TAG, EXP_LEN>>(decoder, ie, deps...);
+				return apply_len<info_t, type_context<typename TYPE_CTX::ie_type, mi_rest, EXP_TAG, EXP_LEN>>(decoder, ie, deps...);
 			}
 		}
 		else
 		{
 			static_assert(mi::kind == mik::TAG);
 			auto const tag = decode_tag<info_t>(decoder);
+			MED_RETURN_ON_ERROR(decoder);
 			if (not info_t::match(tag))
 			{
 				//NOTE: this can only be called for mandatory field thus it's fail case (not unexpected)
-				MED_THROW_EXCEPTION(unknown_tag, name<IE>(), tag)
+				MED_THROW_EXCEPTION(unknown_tag, name<IE>(), tag, decoder)
 			}
-			ie_decode<type_context<typename TYPE_CTX::ie_type, mi_rest, EXP_TAG, EXP_LEN>>(decoder, ie, deps...);
+			return ie_decode<type_context<typename TYPE_CTX::ie_type, mi_rest, EXP_TAG, EXP_LEN>>(decoder, ie, deps...);
 		}
 	}
+	else if constexpr (ACold<IE>)
+	{
+		//allocated once present (see cold)
+		auto* field = ie.emplace(decoder);
+		MED_RETURN_ON_ERROR(decoder);
+		return ie_decode<TYPE_CTX>(decoder, *field, deps...);
+	}
 	else
 	{
 		using ie_type = typename IE::ie_type;
@@ -216,19 +238,20 @@ constexpr void ie_decode(DECODER& decoder, IE& ie, DEPS&... deps)
 				static_assert(std::is_void_v<EXP_LEN>);
 				static_assert(std::is_same_v<EXP_TAG, get_field_type_t<meta::list_first_t<typename IE::ies_types>>>);
 				/* NOTE: 1st IE is expected to be explicit so it s.b. skipped as was decoded in meta */
-				ie.template decode<meta::list_rest_t<typename IE::ies_types>>(decoder, deps...);
+				MED_CHECK_FAIL(ie.template decode<meta::list_rest_t<typename IE::ies_types>>(decoder, deps...));
 			}
 			else if constexpr (not std::is_void_v<EXP_LEN>)
 			{
 				/* NOTE: explicit length is valid for sequence only */
 				using ctx = type_context<typename TYPE_CTX::ie_type, meta::typelist<>, void, EXP_LEN>;
-				ie.template decode<typename IE::ies_types, ctx>(decoder, deps...);
+				MED_CHECK_FAIL((ie.template decode<typename IE::ies_types, ctx>(decoder, deps...)));
 			}
 			else
 			{
-				ie.decode(decoder, deps...);
+				MED_CHECK_FAIL(ie.decode(decoder, deps...));
 			}
 			CODEC_TRACE("<<< %s<%s:%s>", name<IE>(), name<EXP_TAG>(), name<EXP_LEN>());
+			MED_RETURN_SUCCESS;
 		}
 		else
 		{
@@ -237,11 +260,11 @@ constexpr void ie_decode(DECODER& decoder, IE& ie, DEPS&... deps)
 
 			if constexpr (std::is_same_v<field_t, EXP_LEN>)
 			{
-				explicit_len_commit(decoder, ie, deps...);
+				return explicit_len_commit(decoder, ie, deps...);
 			}
 			else
 			{
-				decoder(ie, ie_type{});
+				return decoder(ie, ie_type{});
 			}
 		}
 	}
@@ -250,10 +273,45 @@ constexpr void ie_decode(DECODER& decoder, IE& ie, DEPS&... deps)
 }	//end: namespace sl
 
 template <class DECODER, AHasIeType IE, class... DEPS>
-constexpr void decode(DECODER&& decoder, IE& ie, DEPS&... deps)
+constexpr MED_RESULT decode(DECODER&& decoder, IE& ie, DEPS&... deps)
 {
 	using META_INFO = meta::produce_info_t<DECODER, IE>;
-	sl::ie_decode<type_context<typename IE::ie_type, META_INFO>>(decoder, ie, deps...);
+	return sl::ie_decode<type_context<typename IE::ie_type, META_INFO>>(decoder, ie, deps...);
+}
+
+/**
+ * Decodes only the IEs given skipping the rest by their framing: the values
+ * of other IEs with length are not decoded and their instances are not stored.
+ * The arity of selected IEs is checked as usual.
+ * NOTE: IEs w/o length (e.g. fixed-size values or containers w/o length) can't
+ * be skipped and are decoded as usual so conditions and counters may refer
+ * them while skipped IEs with length are left unset.
+ * @tparam FIELDS IEs to decode
+ */
+template <class... FIELDS, class DECODER, AHasIeType IE> requires (sizeof...(FIELDS) > 0)
+constexpr MED_RESULT decode(DECODER&& decoder, IE& ie)
+{
+	selective_decoder<std::remove_cvref_t<DECODER>, meta::typelist<FIELDS...>, IE> sd{decoder};
+	return decode(sd, ie);
+}
+
+/**
+ * Validates the encoded message: the tags, lengths, values and arity are
+ * checked the same way as by decode but w/o message instance. Its shadow is
+ * decoded instead where nested containers are decoded one at a time into own
+ * shadow on stack and discarded once checked. The instances of multi-fields
+ * are counted only and the octet strings with internal storage are not copied
+ * so no allocator is needed.
+ * NOTE: presence conditions and counters can't refer IEs of nested containers
+ * @tparam MSG message to validate as
+ * @return the 1st violation found as decode does
+ */
+template <class MSG, class DECODER> requires AHasIeType<MSG>
+constexpr MED_RESULT validate(DECODER&& decoder)
+{
+	validating_decoder<std::remove_cvref_t<DECODER>> vd{decoder};
+	detail::shadow_ie_t<MSG> shadow;
+	return decode(vd, shadow);
 }
 
 }	//end: namespace med
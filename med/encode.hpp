@@ -28,15 +28,165 @@ namespace sl {
 
 //Tag
 template <class TAG_TYPE, class ENCODER>
-constexpr void encode_tag(ENCODER& encoder)
+constexpr MED_RESULT encode_tag(ENCODER& encoder)
 {
 	TAG_TYPE const ie{};
 	CODEC_TRACE("%s=%zX[%s]", __FUNCTION__, std::size_t(ie.get_encoded()), name<TAG_TYPE>());
-	encoder(ie, IE_TAG{});
+	return encoder(ie, IE_TAG{});
 }
 
 template <class TYPE_CTX, class ENCODER, class IE>
-constexpr void ie_encode(ENCODER& encoder, IE const& ie)
+constexpr MED_RESULT ie_encode(ENCODER& encoder, IE const& ie);
+
+//encoder able to patch the fixed-width length after encoding the IE
+template <class ENCODER>
+concept APatchLength = requires { requires ENCODER::patch_length; };
+
+//encoder writing the output from the end towards the start (see reverse_buffer)
+template <class ENCODER>
+concept AReverseEncoder = requires
+{
+	requires std::remove_reference_t<decltype(std::declval<ENCODER&>().get_context().buffer())>::reverse;
+};
+
+//encoder with context to keep snapshots (see encoder_context)
+template <class ENCODER>
+concept ASnapshotEncoder = requires
+{
+	requires std::remove_reference_t<decltype(std::declval<ENCODER&>().get_context())>::snapshots > 0;
+};
+
+//visits fields of multi-field in the order of encoding
+template <class ENCODER, class IE, class FUNC>
+constexpr MED_RESULT foreach_field(IE const& ie, FUNC&& func)
+{
+	if constexpr (AReverseEncoder<ENCODER> && std::bidirectional_iterator<typename IE::const_iterator>)
+	{
+		for (auto it = ie.end(); it != ie.begin(); )
+		{
+			MED_CHECK_FAIL(func(*--it));
+		}
+		MED_RETURN_SUCCESS;
+	}
+	else if constexpr (AReverseEncoder<ENCODER>)
+	{
+		//fields are linked forward only: recurse by chunks to visit them backwards
+		auto visit = [&func](auto& self, auto it, auto ite) -> MED_RESULT
+		{
+			constexpr std::size_t CHUNK = 16;
+			typename IE::field_type const* fields[CHUNK];
+			std::size_t num = 0;
+			for (; num < CHUNK && it != ite; ++it) { fields[num++] = &*it; }
+			if (it != ite) { MED_CHECK_FAIL(self(self, it, ite)); }
+			while (num) { MED_CHECK_FAIL(func(*fields[--num])); }
+			MED_RETURN_SUCCESS;
+		};
+		return visit(visit, ie.begin(), ie.end());
+	}
+	else
+	{
+		for (auto& field : ie) { MED_CHECK_FAIL(func(field)); }
+		MED_RETURN_SUCCESS;
+	}
+}
+
+//back-to-front: IE is encoded before its length and tag so the length is known
+template <class TYPE_CTX, class MI, class ENCODER, class IE>
+constexpr MED_RESULT encode_reverse(ENCODER& encoder, IE const& ie)
+{
+	using info_t = get_info_t<MI>;
+	static_assert(!APresentIn<info_t, IE>, "EXPLICIT META-INFO IS NOT SUPPORTED IN REVERSE");
+
+	if constexpr (MI::kind == mik::TAG)
+	{
+		MED_CHECK_FAIL(ie_encode<TYPE_CTX>(encoder, ie));
+		return encode_tag<info_t>(encoder);
+	}
+	else
+	{
+		static_assert(std::is_void_v<typename get_padding<info_t>::type>, "PADDING IS NOT SUPPORTED IN REVERSE");
+		auto const end = encoder(GET_STATE{});
+		MED_CHECK_FAIL(ie_encode<TYPE_CTX>(encoder, ie));
+		std::size_t len = encoder(GET_STATE{}) - end;
+		using dependency_t = get_dependency_t<info_t>;
+		if constexpr (!std::is_void_v<dependency_t>)
+		{
+			len -= info_t::dependency(ie.template get<dependency_t>());
+		}
+		CODEC_TRACE("reverse L[%s]=%zX", name<info_t>(), len);
+		info_t ie_len;
+		MED_CHECK_FAIL(length_to_value(encoder, ie_len, len));
+		return encoder(ie_len, IE_LEN{});
+	}
+}
+
+//single pass: reserve the length, encode IE then patch the length with actual value
+template <class TYPE_CTX, class LEN, class ENCODER, class IE>
+constexpr MED_RESULT encode_patched(ENCODER& encoder, IE const& ie)
+{
+	LEN own_len;
+	LEN& ie_len = [&]() -> LEN&
+	{
+		//TODO: a way to avoid cast?
+		if constexpr (APresentIn<LEN, IE>) { return const_cast<IE&>(ie).template ref<LEN>(); }
+		else { return own_len; }
+	}();
+
+	auto const start = encoder(GET_STATE{});
+	std::size_t len_offset = 0; //from the start
+	if constexpr (APresentIn<LEN, IE>)
+	{
+		//explicit length is encoded along with IE after the fields preceding it
+		using prefix = meta::list_before_t<typename IE::ies_types, field_at<LEN>>;
+		len_offset = ie.template calc_length<prefix, type_context<typename IE::ie_type>>(encoder);
+		//mandatory length s.b. set to be encoded
+		if (not ie_len.is_set()) { (void)ie_len.set_encoded(0); }
+	}
+	else
+	{
+		MED_CHECK_FAIL(encoder(ie_len, IE_LEN{})); //reserve
+	}
+	auto const len_size = encoder(GET_LENGTH{}, ie_len);
+	MED_CHECK_FAIL(ie_encode<TYPE_CTX>(encoder, ie));
+	auto const end = encoder(GET_STATE{});
+
+	//explicit length and tag are not accounted while padding is applied after implicit length only
+	std::size_t const size = end - start;
+	[[maybe_unused]] std::size_t const padded_len = APresentIn<LEN, IE> ? size : size - len_size;
+	std::size_t len = size - len_size;
+	//NOTE: explicit tag of choice is encoded before the length
+	using exp_tag_t = typename TYPE_CTX::explicit_tag_type;
+	if constexpr (not std::is_void_v<exp_tag_t> && not std::is_same_v<IE_CHOICE, typename TYPE_CTX::ie_type>)
+	{
+		len -= encoder(GET_LENGTH{}, exp_tag_t{});
+	}
+	using dependency_t = get_dependency_t<LEN>;
+	if constexpr (!std::is_void_v<dependency_t>)
+	{
+		len -= LEN::dependency(ie.template get<dependency_t>());
+	}
+	CODEC_TRACE("patch L[%s]=%zX @%zu", name<LEN>(), len, len_offset);
+	MED_CHECK_FAIL(length_to_value(encoder, ie_len, len));
+	encoder(SET_STATE{}, start);
+	if (len_offset) { MED_CHECK_FAIL(encoder(ADVANCE_STATE{int(len_offset)})); }
+	MED_CHECK_FAIL(encoder(ie_len, IE_LEN{}));
+	encoder(SET_STATE{}, end);
+
+	using pad_traits = typename get_padding<LEN>::type;
+	if constexpr (!std::is_void_v<pad_traits>)
+	{
+		using pad_t = typename ENCODER::template padder_type<pad_traits, ENCODER>;
+		if (auto const pad_size = pad_t::calc_padding_size(padded_len))
+		{
+			CODEC_TRACE("PADDING %zu bytes", pad_size);
+			return encoder(ADD_PADDING{uint8_t(pad_size), pad_traits::filler});
+		}
+	}
+	MED_RETURN_SUCCESS;
+}
+
+template <class TYPE_CTX, class ENCODER, class IE>
+constexpr MED_RESULT ie_encode(ENCODER& encoder, IE const& ie)
 {
 	using META_INFO = typename TYPE_CTX::meta_info_type;
 	using EXP_TAG = typename TYPE_CTX::explicit_tag_type;
@@ -51,21 +201,30 @@ constexpr void ie_encode(ENCODER& encoder, IE const& ie)
 		using ctx = type_context<typename TYPE_CTX::ie_type, meta::list_rest_t<META_INFO>, exp_tag_t, exp_len_t>;
 		CODEC_TRACE("%s[%s]<%s:%s>: %s", __FUNCTION__, name<IE>(), name<exp_tag_t>(), name<exp_len_t>(), class_name<mi>());
 
-		if constexpr (mi::kind == mik::TAG)
+		if constexpr (AReverseEncoder<ENCODER>)
+		{
+			return encode_reverse<ctx, mi>(encoder, ie);
+		}
+		else if constexpr (mi::kind == mik::TAG)
 		{
 			if constexpr (!APresentIn<info_t, IE>)
 			{
-				encode_tag<info_t>(encoder);
+				MED_CHECK_FAIL(encode_tag<info_t>(encoder));
 			}
 			else
 			{
 				CODEC_TRACE("skip explicit T[%s]", name<info_t>());
 			}
 		}
+		else if constexpr (mi::kind == mik::LEN && APatchLength<ENCODER>)
+		{
+			return encode_patched<ctx, info_t>(encoder, ie);
+		}
 		else if constexpr (mi::kind == mik::LEN)
 		{
 			using len_t = info_t;
 			auto len = sl::ie_length<ctx>(ie, encoder);
+			MED_RETURN_ON_ERROR(encoder);
 			CODEC_TRACE("LV[%s]=%zX%c", name<len_t>(), len, AMultiField<IE>?'*':' ');
 			using dependency_t = get_dependency_t<len_t>;
 			if constexpr (!std::is_void_v<dependency_t>)
@@ -79,14 +238,14 @@ constexpr void ie_encode(ENCODER& encoder, IE const& ie)
 			{
 				//TODO: a way to avoid cast?
 				auto& ie_len = const_cast<IE&>(ie).template ref<len_t>();
-				length_to_value(ie_len, len);
+				MED_CHECK_FAIL(length_to_value(encoder, ie_len, len));
 				CODEC_TRACE("explicit LV[%s]=%zX", name<len_t>(), std::size_t(ie_len.get_encoded()));
 			}
 			else
 			{
 				len_t ie_len;
-				length_to_value(ie_len, len);
-				encoder(ie_len, IE_LEN{});
+				MED_CHECK_FAIL(length_to_value(encoder, ie_len, len));
+				MED_CHECK_FAIL(encoder(ie_len, IE_LEN{}));
 			}
 
 			using pad_traits = typename get_padding<len_t>::type;
@@ -95,13 +254,16 @@ constexpr void ie_encode(ENCODER& encoder, IE const& ie)
 				CODEC_TRACE("padded len_type=%s...:", name<len_t>());
 				using pad_t = typename ENCODER::template padder_type<pad_traits, ENCODER>;
 				pad_t pad{encoder};
-				ie_encode<ctx>(encoder, ie);
-				pad.add_padding();
-				return;
+				MED_CHECK_FAIL(ie_encode<ctx>(encoder, ie));
+				return pad.add_padding();
 			}
 		}
 
-		ie_encode<ctx>(encoder, ie);
+		return ie_encode<ctx>(encoder, ie);
+	}
+	else if constexpr (ACold<IE>)
+	{
+		return ie_encode<TYPE_CTX>(encoder, *ie.get());
 	}
 	else
 	{
@@ -112,7 +274,7 @@ constexpr void ie_encode(ENCODER& encoder, IE const& ie)
 			//special case for printer
 			if constexpr (requires { typename ENCODER::container_encoder; })
 			{
-				typename ENCODER::container_encoder{}(encoder, ie);
+				return typename ENCODER::container_encoder{}(encoder, ie);
 			}
 			else
 			{
@@ -121,24 +283,25 @@ constexpr void ie_encode(ENCODER& encoder, IE const& ie)
 				if constexpr (std::is_same_v<IE_CHOICE, typename TYPE_CTX::ie_type> && !std::is_void_v<EXP_TAG>)
 				{
 					CODEC_TRACE(">>> %s<%s:%s>", name<IE>(), name<EXP_TAG>(), name<EXP_LEN>());
-					ie.template encode<meta::list_rest_t<typename IE::ies_types>>(encoder);
+					MED_CHECK_FAIL(ie.template encode<meta::list_rest_t<typename IE::ies_types>>(encoder));
 					CODEC_TRACE("<<< %s<%s:%s>", name<IE>(), name<EXP_TAG>(), name<EXP_LEN>());
 				}
 				else
 				{
 					CODEC_TRACE(">>> %s", name<IE>());
-					ie.encode(encoder);
+					MED_CHECK_FAIL(ie.encode(encoder));
 					CODEC_TRACE("<<< %s", name<IE>());
 				}
+				MED_RETURN_SUCCESS;
 			}
 		}
 		else
 		{
-			if constexpr (!std::is_same_v<null_allocator, std::remove_const_t<typename ENCODER::allocator_type>>)
+			if constexpr (ASnapshotEncoder<ENCODER> && !AReverseEncoder<ENCODER>)
 			{
-				put_snapshot(encoder, ie);
+				MED_CHECK_FAIL(put_snapshot(encoder, ie));
 			}
-			encoder(ie, ie_type{});
+			return encoder(ie, ie_type{});
 		}
 	}
 }
@@ -146,11 +309,11 @@ constexpr void ie_encode(ENCODER& encoder, IE const& ie)
 }	//end: namespace sl
 
 template <class ENCODER, AHasIeType IE>
-constexpr void encode(ENCODER&& encoder, IE const& ie)
+constexpr MED_RESULT encode(ENCODER&& encoder, IE const& ie)
 {
 	using META_INFO = meta::produce_info_t<ENCODER, IE>;
 	CODEC_TRACE("mi=%s by %s for %s", class_name<META_INFO>(), class_name<ENCODER>(), class_name<IE>());
-	sl::ie_encode<type_context<typename IE::ie_type, META_INFO>>(encoder, ie);
+	return sl::ie_encode<type_context<typename IE::ie_type, META_INFO>>(encoder, ie);
 }
 
 }	//end: namespace med
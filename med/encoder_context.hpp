@@ -9,6 +9,8 @@ Distributed under the MIT License
 
 #pragma once
 
+#include <array>
+#include <bit>
 
 #include "allocator.hpp"
 #include "snapshot.hpp"
@@ -17,9 +19,23 @@ Distributed under the MIT License
 
 namespace med {
 
+namespace detail {
+
+//snapshots are kept by default when encoding with allocator
+template <class ALLOCATOR>
+constexpr std::size_t default_snapshots = std::is_same_v<null_allocator, std::remove_const_t<ALLOCATOR>> ? 0 : 16;
+
+} //end: namespace detail
+
+/**
+ * Context of encoding: the buffer, allocator and snapshots of IEs to update.
+ * @tparam SNAPSHOTS number of IEs with_snapshot kept w/o allocation (0 to
+ *         disable) while the rest is allocated from the allocator if any
+ */
 template <
 		class ALLOCATOR = const null_allocator,
-		class BUFFER = buffer<uint8_t>
+		class BUFFER = buffer<uint8_t>,
+		std::size_t SNAPSHOTS = detail::default_snapshots<ALLOCATOR>
 		>
 class encoder_context : public detail::allocator_holder<ALLOCATOR>
 {
@@ -27,14 +43,21 @@ public:
 	using allocator_type = ALLOCATOR;
 	using buffer_type = BUFFER;
 	using state_t = typename buffer_type::state_type;
+	static constexpr std::size_t snapshots = SNAPSHOTS;
 
 private:
 	struct snapshot_s
 	{
 		SNAPSHOT    snapshot;
 		state_t     state;
-		snapshot_s* next;
 	};
+	//snapshot beyond the table
+	struct spill_s : snapshot_s
+	{
+		spill_s*    next;
+	};
+	//open addressing by hash of snapshot id
+	static constexpr std::size_t SLOTS = std::bit_ceil(SNAPSHOTS);
 
 public:
 	encoder_context(encoder_context const&) = delete;
@@ -54,22 +77,41 @@ public:
 	constexpr void reset(Ts... args) noexcept
 	{
 		buffer().reset(args...);
-		m_snapshot = nullptr;
+		reset_snapshots();
+	}
+
+	//drops the snapshots (e.g. of previous message encoded into the same buffer)
+	constexpr void reset_snapshots() noexcept
+	{
+		if (m_snapshots)
+		{
+			for (auto& s : m_slots) { s.snapshot.id = nullptr; }
+			m_snapshots = 0;
+			m_spill = nullptr;
+		}
 	}
 
 	/**
-	 * Stores the buffer snapshot
+	 * Stores the buffer snapshot replacing the one of the same IE
 	 * @param snap
 	 */
-	constexpr void put_snapshot(SNAPSHOT snap)
+	constexpr MED_RESULT put_snapshot(SNAPSHOT snap)
 	{
 		CODEC_TRACE("snapshot %p{%zu}", static_cast<void const*>(snap.id), snap.size);
-		snapshot_s* p = create<snapshot_s>(this->get_allocator());
+		snapshot_s* p = find(snap.id, snap.hash);
+		if (!p && !(p = find_spill(snap.id)))
+		{
+			//table is full: from allocator
+			auto* ps = create<spill_s>(this->get_allocator());
+			if (!ps) { MED_THROW_EXCEPTION(out_of_memory, "snapshot", sizeof(spill_s), m_buffer) }
+			ps->next = m_spill;
+			m_spill = ps;
+			p = ps;
+		}
+		else if (!p->snapshot.id) { ++m_snapshots; }
 		p->snapshot = snap;
 		p->state = m_buffer.get_state();
-
-		p->next = m_snapshot ? m_snapshot->next : nullptr;
-		m_snapshot = p;
+		MED_RETURN_SUCCESS;
 	}
 
 	class snap_s : public state_t
@@ -100,18 +142,41 @@ public:
 	{
 		static_assert(std::is_base_of<with_snapshot, IE>(), "IE WITH with_snapshot EXPECTED");
 
-		for (snapshot_s const* p = m_snapshot; p != nullptr; p = p->next)
+		auto* self = const_cast<encoder_context*>(this);
+		snapshot_s const* p = self->find(snapshot_id<IE>, snapshot_hash<IE>);
+		if (!p || !p->snapshot.id) { p = self->find_spill(snapshot_id<IE>); }
+		return p ? snap_s{p->state, p->snapshot.size} : snap_s{};
+	}
+
+private:
+	//slot of the snapshot or the empty one to put it into
+	constexpr snapshot_s* find(SNAPSHOT::id_type id, std::size_t hash)
+	{
+		for (std::size_t i = 0; i < SLOTS; ++i)
 		{
-			if (p->snapshot.id == snapshot_id<IE>) { return snap_s{p->state, p->snapshot.size}; }
+			auto& s = m_slots[(hash + i) & (SLOTS - 1)];
+			if (s.snapshot.id == id || s.snapshot.id == nullptr)
+			{
+				return (s.snapshot.id || m_snapshots < SNAPSHOTS) ? &s : nullptr;
+			}
 		}
-		return snap_s{};
+		return nullptr;
 	}
 
-private:
-	using const_iterator = snapshot_s const*;
+	//snapshot beyond the table or nullptr
+	constexpr snapshot_s* find_spill(SNAPSHOT::id_type id)
+	{
+		for (auto* p = m_spill; p; p = p->next)
+		{
+			if (p->snapshot.id == id) { return p; }
+		}
+		return nullptr;
+	}
 
 	buffer_type    m_buffer;
-	snapshot_s*    m_snapshot{ nullptr };
+	std::array<snapshot_s, SLOTS> m_slots{};
+	std::size_t    m_snapshots{0};
+	spill_s*       m_spill{nullptr};
 };
 
 } //namespace med
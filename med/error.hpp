@@ -0,0 +1,167 @@
+/**
+@file
+error codes and context for exception-free encoding/decoding
+
+@copyright Denis Priyomov 2016-2017
+Distributed under the MIT License
+(See accompanying file LICENSE or visit https://github.com/cppden/med)
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+#include <concepts>
+
+namespace med {
+
+enum class error : uint8_t
+{
+	success,
+	overflow,
+	invalid_value,
+	unknown_tag,
+	missing_ie,
+	extra_ie,
+	out_of_memory,
+};
+
+//compact descriptor of the 1st error occurred, nothing is formatted until asked
+class error_context
+{
+public:
+	explicit constexpr operator bool() const noexcept   { return error::success != m_error; }
+	constexpr error get_error() const noexcept          { return m_error; }
+	constexpr char const* name() const noexcept         { return m_name; }
+	constexpr std::size_t offset() const noexcept       { return m_offset; }
+	constexpr std::size_t value(std::size_t i) const    { return m_value[i]; }
+
+	constexpr void reset() noexcept                     { m_error = error::success; m_name = nullptr; }
+
+	//only the 1st error is kept since the rest is a consequence of it
+	constexpr void set_error(error err, char const* name, std::size_t v0, std::size_t v1, std::size_t ofs) noexcept
+	{
+		if (not *this)
+		{
+			m_error = err;
+			m_name = name;
+			m_value[0] = v0;
+			m_value[1] = v1;
+			m_offset = ofs;
+		}
+	}
+
+	/**
+	 * Formats error description into given buffer
+	 * @param sz output buffer
+	 * @return the output buffer
+	 */
+	template <std::size_t N>
+	char const* format(char (&sz)[N]) const noexcept
+	{
+		int n = 0;
+		switch (m_error)
+		{
+		case error::success:
+			n = std::snprintf(sz, N, "Success.");
+			break;
+		case error::overflow:
+			n = std::snprintf(sz, N, "'%.32s' needs %zu octets.", m_name, m_value[0]);
+			break;
+		case error::invalid_value:
+			n = std::snprintf(sz, N, "Invalid value of '%.32s' = 0x%zX.", m_name, m_value[0]);
+			break;
+		case error::unknown_tag:
+			n = std::snprintf(sz, N, "Unknown tag of '%.32s' = 0x%zX.", m_name, m_value[0]);
+			break;
+		case error::missing_ie:
+			n = std::snprintf(sz, N, "Missing IE '%.32s': at least %zu expected, got %zu.", m_name, m_value[0], m_value[1]);
+			break;
+		case error::extra_ie:
+			n = std::snprintf(sz, N, "Excessive IE '%.32s': no more than %zu expected, got %zu.", m_name, m_value[0], m_value[1]);
+			break;
+		case error::out_of_memory:
+			n = std::snprintf(sz, N, "No space to allocate '%.32s': %zu octets.", m_name, m_value[0]);
+			break;
+		}
+		if (*this && n > 0 && std::size_t(n) < N)
+		{
+			std::snprintf(sz + n, N - n, " @%zu", m_offset);
+		}
+		return sz;
+	}
+
+private:
+	error       m_error{error::success};
+	char const* m_name{nullptr};
+	std::size_t m_offset{0};
+	std::size_t m_value[2]{};
+};
+
+namespace detail {
+
+//locates the owner of error context: buffer directly or via codec/context
+template <class T>
+constexpr auto* error_holder(T& t)
+{
+	if constexpr (requires { t.error_ctx(); })
+	{
+		return &t;
+	}
+	else if constexpr (requires { t.get_context(); })
+	{
+		return error_holder(t.get_context());
+	}
+	else if constexpr (requires { t.buffer(); })
+	{
+		return error_holder(t.buffer());
+	}
+	else
+	{
+		return static_cast<void*>(nullptr);
+	}
+}
+
+template <class T>
+concept AErrorSink = !std::convertible_to<T, std::size_t>;
+
+template <class EX, class SINK>
+constexpr void record_error(SINK& sink, char const* name, std::size_t v0, std::size_t v1)
+{
+	auto* holder = error_holder(sink);
+	if constexpr (not std::is_same_v<void*, decltype(holder)>)
+	{
+		std::size_t ofs = 0;
+		if constexpr (requires { holder->get_offset(); }) { ofs = holder->get_offset(); }
+		holder->error_ctx().set_error(EX::code, name, v0, v1, ofs);
+	}
+}
+
+//no sink to store the error (e.g. allocation outside of codec) -> just fail
+template <class EX>
+constexpr void set_error(char const*, std::size_t, std::size_t = 0) noexcept {}
+
+template <class EX, AErrorSink SINK>
+constexpr void set_error(char const* name, std::size_t v0, SINK& sink)
+{
+	record_error<EX>(sink, name, v0, 0);
+}
+
+template <class EX, AErrorSink SINK>
+constexpr void set_error(char const* name, std::size_t v0, std::size_t v1, SINK& sink)
+{
+	record_error<EX>(sink, name, v0, v1);
+}
+
+} //end: namespace detail
+
+/**
+ * Retrieves error context of codec, its context or buffer
+ */
+template <class T>
+constexpr error_context& get_error_ctx(T& t)
+{
+	return detail::error_holder(t)->error_ctx();
+}
+
+}	//end: namespace med
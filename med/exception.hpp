@@ -17,9 +17,44 @@ Distributed under the MIT License
 
 #include "config.hpp"
 #include "debug.hpp"
+#include "error.hpp"
 
 namespace med {
 
+namespace detail {
+
+//text of buffer position to append to exception description if available
+template <class CTX>
+char const* buffer_position(CTX const& ctx)
+{
+	auto* holder = error_holder(const_cast<CTX&>(ctx));
+	if constexpr (requires { holder->toString(); })
+	{
+		return holder->toString();
+	}
+	else
+	{
+		return nullptr;
+	}
+}
+
+//offset of buffer if available
+template <class CTX>
+std::size_t buffer_offset(CTX const& ctx)
+{
+	auto* holder = error_holder(const_cast<CTX&>(ctx));
+	if constexpr (requires { holder->get_offset(); })
+	{
+		return holder->get_offset();
+	}
+	else
+	{
+		return 0;
+	}
+}
+
+} //end: namespace detail
+
 class exception : public std::exception
 {
 public:
@@ -48,67 +83,113 @@ protected:
 //OVERFLOW
 struct overflow : exception
 {
+	static constexpr error code = error::overflow;
+
 	overflow(char const* name, std::size_t bytes, char const* bufpos = nullptr) noexcept
+		: m_bytes{bytes}
 		{ format(bufpos, "'%.32s' needs %zu octets.", name, bytes); }
 
 	template <class CTX>
 	overflow(char const* name, std::size_t bytes, CTX const& ctx) noexcept
-		: overflow{name, bytes, ctx.toString()} {}
+		: overflow{name, bytes, detail::buffer_position(ctx)}
+		{ m_offset = detail::buffer_offset(ctx); }
+
+	//number of octets needed at the offset
+	std::size_t bytes() const noexcept  { return m_bytes; }
+	std::size_t offset() const noexcept { return m_offset; }
+
+private:
+	std::size_t m_bytes;
+	std::size_t m_offset{0};
 };
 
 struct value_exception : public exception {};
 
 struct invalid_value : public value_exception
 {
+	static constexpr error code = error::invalid_value;
+
 	invalid_value(char const* name, std::size_t val, char const* bufpos = nullptr) noexcept
 		{ format(bufpos, "Invalid value of '%.32s' = 0x%zX.", name, val); }
 
 	template <class CTX>
 	invalid_value(char const* name, std::size_t val, CTX const& ctx) noexcept
-		: invalid_value{name, val, ctx.toString()} {}
+		: invalid_value{name, val, detail::buffer_position(ctx)} {}
 };
 struct unknown_tag : public value_exception
 {
+	static constexpr error code = error::unknown_tag;
+
 	unknown_tag(char const* name, std::size_t val, char const* bufpos = nullptr) noexcept
 		{ format(bufpos, "Unknown tag of '%.32s' = 0x%zX.", name, val); }
 
 	template <class CTX>
 	unknown_tag(char const* name, std::size_t val, CTX const& ctx) noexcept
-		: unknown_tag{name, val, ctx.toString()} {}
+		: unknown_tag{name, val, detail::buffer_position(ctx)} {}
 };
 
 struct ie_exception : public exception {};
 
 struct missing_ie : public ie_exception
 {
+	static constexpr error code = error::missing_ie;
+
 	missing_ie(char const* name, std::size_t exp, std::size_t got, char const* bufpos = nullptr) noexcept
 		{ format(bufpos, "Missing IE '%.32s': at least %zu expected, got %zu.", name, exp, got); }
 
 	template <class CTX>
 	missing_ie(char const* name, std::size_t exp, std::size_t got, CTX const& ctx) noexcept
-		: missing_ie{name, exp, got, ctx.toString()} {}
+		: missing_ie{name, exp, got, detail::buffer_position(ctx)} {}
 };
 struct extra_ie : public ie_exception
 {
+	static constexpr error code = error::extra_ie;
+
 	extra_ie(char const* name, std::size_t exp, std::size_t got, char const* bufpos = nullptr) noexcept
 		{ format(bufpos, "Excessive IE '%.32s': no more than %zu expected, got %zu.", name, exp, got); }
 
 	template <class CTX>
 	extra_ie(char const* name, std::size_t exp, std::size_t got, CTX const& ctx) noexcept
-		: extra_ie{name, exp, got, ctx.toString()} {}
+		: extra_ie{name, exp, got, detail::buffer_position(ctx)} {}
 };
 
 //OUT_OF_MEMORY
 struct out_of_memory : public exception
 {
+	static constexpr error code = error::out_of_memory;
+
 	out_of_memory(char const* name, std::size_t bytes, char const* bufpos = nullptr) noexcept
 		{ format(bufpos, "No space to allocate '%.32s': %zu octets.", name, bytes); }
 
 	template <class CTX>
 	out_of_memory(char const* name, std::size_t bytes, CTX const& ctx) noexcept
-		: out_of_memory{name, bytes, ctx.toString()} {}
+		: out_of_memory{name, bytes, detail::buffer_position(ctx)} {}
 };
 
+/*
+ * Error handling is selected at compile-time:
+ * - by default an error is reported via exception and codec functions return nothing;
+ * - with MED_NO_EXCEPTION defined the 1st error is stored in the error_context
+ *   of the buffer (see get_error_ctx) and the failure is returned up the call stack.
+ * The last argument of MED_THROW_EXCEPTION is optional and refers to the buffer,
+ * context or codec to report the error position in.
+ */
+#ifdef MED_NO_EXCEPTION
+
+#define MED_RESULT                  bool
+#define MED_RETURN_SUCCESS          return true
+#define MED_CHECK_FAIL(expr)        do { if (!(expr)) return {}; } while (0)
+#define MED_RETURN_ON_ERROR(sink)   do { if (med::get_error_ctx(sink)) return {}; } while (0)
+#define MED_THROW_EXCEPTION(ex, ...) { CODEC_TRACE("ERROR: %s", #ex); med::detail::set_error<ex>(__VA_ARGS__); return {}; }
+
+#else //exceptions
+
+#define MED_RESULT                  void
+#define MED_RETURN_SUCCESS          return
+#define MED_CHECK_FAIL(expr)        (void)(expr)
+#define MED_RETURN_ON_ERROR(sink)   (void)0
 #define MED_THROW_EXCEPTION(ex, ...) { CODEC_TRACE("THROW: %s", #ex); throw ex(__VA_ARGS__); }
 
+#endif //MED_NO_EXCEPTION
+
 }	//end: namespace med
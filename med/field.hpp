@@ -11,6 +11,7 @@ Distributed under the MIT License
 #pragma once
 
 #include <algorithm>
+#include <functional>
 #include <iterator>
 
 #include "ie_type.hpp"
@@ -20,6 +21,7 @@ Distributed under the MIT License
 #include "meta/typelist.hpp"
 #include "allocator.hpp"
 #include "concepts.hpp"
+#include "link.hpp"
 
 
 namespace med {
@@ -43,8 +45,8 @@ struct get_inplace;
 template <std::size_t MIN, std::size_t MAX>
 struct get_inplace<MIN, max<MAX>> : std::integral_constant<std::size_t, MAX> {};
 
-template <std::size_t MIN, std::size_t MAX>
-struct get_inplace<MIN, pmax<MAX>> : std::integral_constant<std::size_t, MIN> {};
+template <std::size_t MIN, std::size_t MAX, class STORAGE>
+struct get_inplace<MIN, pmax<MAX, STORAGE>> : std::integral_constant<std::size_t, MIN> {};
 
 template <class META_INFO>
 struct define_meta_info
@@ -54,32 +56,19 @@ struct define_meta_info
 template <>
 struct define_meta_info<void> {};
 
-} //end: namespace detail
-
-template <AField FIELD, std::size_t MIN, class CMAX, class META_INFO = void, class... FIELD_META_INFO>
-class multi_field : public detail::define_meta_info<META_INFO>
+//instances as linked nodes: addresses are stable, suits fields of any kind
+template <class FIELD, std::size_t INPLACE>
+class multi_list
 {
-	static_assert(MIN > 0, "MIN SHOULD BE GREATER ZERO");
-	static_assert(CMAX::value >= MIN, "MAX SHOULD BE GREATER OR EQUAL TO MIN");
-
 public:
-	using ie_type = typename FIELD::ie_type;
-	using field_type = field_t<FIELD, FIELD_META_INFO...>;
+	using field_type = FIELD;
 
 	struct field_value
 	{
-		field_type   value;
-		field_value* next;
+		field_type        value;
+		link<field_value> next;
 	};
 
-	static constexpr std::size_t min = MIN;
-	static constexpr std::size_t max = CMAX::value;
-	static constexpr std::size_t inplace = detail::get_inplace<MIN, CMAX>::value;
-
-	multi_field(multi_field const&) = delete;
-	multi_field& operator= (multi_field const&) = delete;
-	multi_field() = default;
-
 private:
 	template <class T>
 	class iter_type
@@ -92,7 +81,7 @@ private:
 		using reference = conditional_t<std::is_const_v<T>, field_type const&, field_type&>;
 
 		explicit iter_type(value_type* p = nullptr) : m_curr{p} { }
-		iter_type& operator++()                     { m_curr = m_curr ? m_curr->next : nullptr; return *this; }
+		iter_type& operator++()                     { m_curr = m_curr ? m_curr->next.get() : nullptr; return *this; }
 		iter_type operator++(int)                   { iter_type ret = *this; ++(*this); return ret;}
 		bool operator==(iter_type const& rhs) const { return m_curr == rhs.m_curr; }
 		bool operator!=(iter_type const& rhs) const { return !(*this == rhs); }
@@ -102,7 +91,7 @@ private:
 		explicit operator bool() const              { return nullptr != m_curr; }
 
 	private:
-		template <AField, std::size_t, class, class, class...> friend class multi_field;
+		friend class multi_list;
 		value_type* m_curr;
 	};
 
@@ -117,34 +106,117 @@ public:
 	std::size_t count() const                               { return m_count; }
 	bool empty() const                                      { return nullptr == m_head; }
 	//NOTE: clear won't return items allocated from external storage, use reset there
+	//NOTE: the instances are cleared when reused so the reset is O(1)
 	void clear()
 	{
-		for (auto& v : *this) { v.clear(); }
-		m_head = m_tail = nullptr;
+		m_head = m_tail = m_free = nullptr;
 		m_count = 0;
+		m_used = 0;
+	}
+	//clears and drops the cold IEs kept by inplace instances (see cold)
+	void reset()
+	{
+		for (auto& f : m_fields) { f.value.reset(); }
+		clear();
 	}
-	bool is_set() const                                     { return not empty() && m_head->value.is_set(); }
 
 	field_type* first()                                     { return empty() ? nullptr : &m_head->value; }
 	field_type* last()                                      { return empty() ? nullptr : &m_tail->value; }
-	field_type const* first() const                         { return const_cast<multi_field*>(this)->first(); }
-	field_type const* last() const                          { return const_cast<multi_field*>(this)->last(); }
+	field_type const* first() const                         { return const_cast<multi_list*>(this)->first(); }
+	field_type const* last() const                          { return const_cast<multi_list*>(this)->last(); }
+
+	/**
+	 * Appends new instance: inplace storage only w/o allocator in context
+	 * or inplace, reserved or external storage otherwise
+	 * @param ctx optional context with allocator or just to report the error
+	 * NOTE: check for max is done during encode/decode
+	 */
+	template <class... CTX> field_type* push_back(CTX&... ctx) requires (sizeof...(CTX) <= 1)
+	{
+		auto* pf = get_free_inplace(); //try inplace 1st then reserved then external
+		if constexpr (requires { get_allocator(ctx...); })
+		{
+			if (!pf && m_free)
+			{
+				pf = m_free;
+				m_free = m_free->next;
+			}
+			if (!pf) { pf = reachable(create<field_value>(get_allocator(ctx...))); }
+		}
+		return append(pf, ctx...);
+	}
 
-	//uses inplace storage only
-	field_type* push_back()                                 { return append(get_free_inplace()); }
+	//counts new instance decoded into the 1st slot (to validate only)
+	//NOTE: only count is valid after that so the field is to be discarded
+	field_type* push_counted()
+	{
+		auto* pf = &m_fields[0];
+		pf->value.clear();
+		pf->next = nullptr;
+		m_head = m_tail = pf;
+		m_used = 1;
+		++m_count;
+		return &pf->value;
+	}
 
-	//uses inplace or external storage
-	//NOTE: check for max is done during encode/decode
-	template <class CTX> field_type* push_back(CTX& ctx)
+	/**
+	 * Preallocates nodes by single allocation to have total number of instances
+	 * @param num total number of instances expected
+	 * @param ctx context with allocator and to report the error
+	 */
+	template <class CTX> MED_RESULT reserve(std::size_t num, CTX& ctx)
 	{
-		auto* pf = get_free_inplace(); //try inplace 1st then external
-		return append(pf ? pf : create<field_value>(get_allocator(ctx)));
+		std::size_t avail = count() + (count() < INPLACE ? INPLACE - count() : 0);
+		for (field_value* p = m_free; p && avail < num; p = p->next) { ++avail; }
+		if (avail < num)
+		{
+			auto const need = num - avail;
+			auto* pf = reachable(create_array<field_value>(get_allocator(ctx), need), need);
+			if (!pf) { MED_THROW_EXCEPTION(out_of_memory, name<field_type>(), need * sizeof(field_value), ctx) }
+			for (std::size_t i = 0; i < need; ++i)
+			{
+				pf[i].next = m_free;
+				m_free = pf + i;
+			}
+		}
+		MED_RETURN_SUCCESS;
+	}
+
+	/**
+	 * Takes over the instances of other list leaving it empty: the external
+	 * nodes (incl. reserved) are relinked as is while the inplace ones are
+	 * transferred into own inplace slots.
+	 * @param from list to take the instances from
+	 * @param func functor called as func(field_type& to, field_type& from) per inplace one
+	 * NOTE: the external nodes are to outlive this list (e.g. shared arena)
+	 */
+	template <class FUNC>
+	void splice(multi_list& from, FUNC&& func)
+	{
+		clear();
+		for (field_value *p = from.m_head, *next; p; p = next)
+		{
+			next = p->next;
+			if (from.is_inplace(p))
+			{
+				auto* pf = &m_fields[m_used++];
+				pf->value.clear(); //stale since clear
+				func(pf->value, p->value);
+				append(pf);
+			}
+			else
+			{
+				append(p);
+			}
+		}
+		m_free = from.m_free;
+		from.clear();
 	}
 
 	//won't recover space if external storage was used
 	void pop_back()
 	{
-		if (auto* prev = m_head)
+		if (field_value* prev = m_head)
 		{
 			//clear the last
 			--m_count;
@@ -153,7 +225,6 @@ public:
 			//locate previous before last
 			for (std::size_t i = 1; i < count(); ++i)
 			{
-				//CODEC_TRACE("%s: %s[%zu]=%p", __FUNCTION__, name<field_type>(), i, (void*)prev->next);
 				prev = prev->next;
 			}
 
@@ -207,29 +278,45 @@ public:
 		return end();
 	}
 
-	bool operator==(multi_field const& rhs) const noexcept
+protected:
+	multi_list() = default;
+
+private:
+	bool is_inplace(field_value const* p) const
 	{
-		return count() == rhs.count() && std::equal(begin(), end(), rhs.begin());
+		return !std::less<field_value const*>{}(p, m_fields) && std::less<field_value const*>{}(p, m_fields + INPLACE);
 	}
 
-private:
-	//find unset inplace slot
+	//allocation out of link range is unusable (see MED_LINK_OFFSET)
+	field_value* reachable(field_value* p, std::size_t num = 1) const
+	{
+		return (p && m_head.reaches(p) && m_head.reaches(p + num - 1)) ? p : nullptr;
+	}
+
+	//find inplace slot never taken since clear or unset one (e.g. by erase)
 	field_value* get_free_inplace()
 	{
-		if (count() < inplace)
+		if (count() < INPLACE)
 		{
+			if (m_used < INPLACE)
+			{
+				auto* pf = &m_fields[m_used++];
+				pf->value.clear(); //stale since clear
+				return pf;
+			}
 			for (auto& f : m_fields)
 			{
-				CODEC_TRACE("%s: %s=%p[%c][%zu]", __FUNCTION__, name<field_type>(), (void*)&f, f.value.is_set()?'+':'-', inplace);
+				CODEC_TRACE("%s: %s=%p[%c][%zu]", __FUNCTION__, name<field_type>(), (void*)&f, f.value.is_set()?'+':'-', INPLACE);
 				if (!f.value.is_set()) return &f;
 			}
 		}
 		return nullptr;
 	}
 
-	field_type* append(field_value* pf)
+	//sink is optional context to report the error into
+	field_type* append(field_value* pf, auto&... sink)
 	{
-		if (!pf) { MED_THROW_EXCEPTION(out_of_memory, name<field_type>(), sizeof(field_type)) }
+		if (!pf) { MED_THROW_EXCEPTION(out_of_memory, name<field_type>(), sizeof(field_type), sink...) }
 
 		if (m_count++) { m_tail->next = pf; }
 		else { m_head = m_tail = pf; }
@@ -239,10 +326,253 @@ private:
 		return &m_tail->value;
 	}
 
-	field_value  m_fields[inplace];
-	std::size_t  m_count {0};
-	field_value* m_head {nullptr};
-	field_value* m_tail {nullptr};
+	field_value       m_fields[INPLACE];
+	std::size_t       m_count {0};
+	std::size_t       m_used {0}; //inplace slots taken since clear
+	link<field_value> m_head;
+	link<field_value> m_tail;
+	link<field_value> m_free; //reserved nodes
+};
+
+/**
+ * Instances in contiguous memory (aka small vector): inplace array first then
+ * a block from allocator where all instances are moved to when it's exceeded.
+ * The block is grown twice (up to max) by allocating a new one, the old block
+ * is not recovered as with any external storage.
+ * NOTE: growth invalidates pointers and iterators to the instances so it's
+ *       opted in explicitly (see vmax).
+ */
+template <class FIELD, std::size_t INPLACE, std::size_t MAX>
+class multi_vector
+{
+public:
+	using field_type = FIELD;
+	using field_value = field_type; //unit of storage
+
+	using iterator = field_type*;
+	using const_iterator = field_type const*;
+	iterator begin()                                        { return data(); }
+	iterator end()                                          { return data() + count(); }
+	const_iterator begin() const                            { return data(); }
+	const_iterator end() const                              { return data() + count(); }
+
+	std::size_t count() const                               { return m_count; }
+	std::size_t capacity() const                            { return m_ext ? m_capacity : INPLACE; }
+	bool empty() const                                      { return 0 == count(); }
+	//NOTE: clear won't return items allocated from external storage, use reset there
+	//NOTE: the instances are cleared when reused so the reset is O(1)
+	void clear()
+	{
+		m_ext = nullptr;
+		m_count = 0;
+	}
+
+	field_type* data()                                      { return m_ext ? m_ext : m_fields; }
+	field_type const* data() const                          { return m_ext ? m_ext : m_fields; }
+	field_type& operator[](std::size_t i)                   { return data()[i]; }
+	field_type const& operator[](std::size_t i) const       { return data()[i]; }
+
+	field_type* first()                                     { return empty() ? nullptr : data(); }
+	field_type* last()                                      { return empty() ? nullptr : data() + count() - 1; }
+	field_type const* first() const                         { return const_cast<multi_vector*>(this)->first(); }
+	field_type const* last() const                          { return const_cast<multi_vector*>(this)->last(); }
+
+	/**
+	 * Appends new instance: storage allocated already only w/o allocator in
+	 * context or grown from allocator otherwise
+	 * @param ctx optional context with allocator or just to report the error
+	 * NOTE: check for max is done during encode/decode
+	 */
+	template <class... CTX> field_type* push_back(CTX&... ctx) requires (sizeof...(CTX) <= 1)
+	{
+		if (count() == capacity())
+		{
+			if constexpr (requires { get_allocator(ctx...); })
+			{
+				auto const num = std::max(count() + 1, std::min(2 * capacity(), MAX));
+				if (!grow(num, ctx...)) { MED_THROW_EXCEPTION(out_of_memory, name<field_type>(), num * sizeof(field_type), ctx...) }
+			}
+			else
+			{
+				MED_THROW_EXCEPTION(out_of_memory, name<field_type>(), sizeof(field_type), ctx...)
+			}
+		}
+		return append();
+	}
+
+	//counts new instance decoded into the 1st slot (to validate only)
+	//NOTE: only count is valid after that so the field is to be discarded
+	field_type* push_counted()
+	{
+		m_ext = nullptr;
+		m_fields[0].clear();
+		++m_count;
+		return m_fields;
+	}
+
+	/**
+	 * Preallocates contiguous block by single allocation for number of instances
+	 * @param num total number of instances expected
+	 * @param ctx context with allocator and to report the error
+	 */
+	template <class CTX> MED_RESULT reserve(std::size_t num, CTX& ctx)
+	{
+		if (num > capacity() && !grow(num, ctx))
+		{
+			MED_THROW_EXCEPTION(out_of_memory, name<field_type>(), num * sizeof(field_type), ctx)
+		}
+		MED_RETURN_SUCCESS;
+	}
+
+	/**
+	 * Takes over the instances of other vector leaving it empty: the external
+	 * block is taken as is while the inplace instances are transferred.
+	 * @param from vector to take the instances from
+	 * @param func functor called as func(field_type& to, field_type& from) per inplace one
+	 * NOTE: the external block is to outlive this vector (e.g. shared arena)
+	 */
+	template <class FUNC>
+	void splice(multi_vector& from, FUNC&& func)
+	{
+		clear();
+		if (from.m_ext)
+		{
+			m_ext = from.m_ext;
+			m_capacity = from.m_capacity;
+			m_count = from.m_count;
+		}
+		else
+		{
+			for (auto& v : from) { func(*append(), v); }
+		}
+		from.clear();
+	}
+
+	void pop_back()
+	{
+		if (count()) { data()[--m_count].clear(); }
+	}
+
+	iterator erase(iterator pos)
+	{
+		if (pos < begin() || pos >= end())
+		{
+			CODEC_TRACE("%s: %s[%c]", __FUNCTION__, name<field_type>(), '-');
+			return end();
+		}
+		std::copy(pos + 1, end(), pos);
+		pop_back();
+		CODEC_TRACE("%s(%s=%p) count=%zu", __FUNCTION__, name<field_type>(), (void*)pos, count());
+		return pos;
+	}
+
+protected:
+	multi_vector() = default;
+
+private:
+	field_type* append()
+	{
+		CODEC_TRACE("%s(%s) count=%zu/%zu", __FUNCTION__, name<field_type>(), count() + 1, capacity());
+		auto* pf = data() + m_count++;
+		pf->clear(); //stale since clear
+		return pf;
+	}
+
+	template <class CTX> field_type* grow(std::size_t num, CTX& ctx)
+	{
+		auto* p = create_array<field_type>(get_allocator(ctx), num);
+		//allocation out of link range is unusable (see MED_LINK_OFFSET)
+		if (p && m_ext.reaches(p) && m_ext.reaches(p + num - 1))
+		{
+			CODEC_TRACE("%s(%s) capacity=%zu->%zu", __FUNCTION__, name<field_type>(), capacity(), num);
+			std::copy(begin(), end(), p);
+			for (auto& v : *this) { v.clear(); }
+			m_ext = p;
+			m_capacity = num;
+			return p;
+		}
+		return nullptr;
+	}
+
+	field_type       m_fields[INPLACE];
+	std::size_t      m_count {0};
+	link<field_type> m_ext;
+	std::size_t      m_capacity {0};
+};
+
+//field which can be moved to contiguous storage by plain copy
+template <class FIELD>
+concept ARelocatable = !AContainer<FIELD> && std::is_trivially_copyable_v<FIELD> && std::is_copy_assignable_v<FIELD>;
+
+//storage selected by the bound of multi-field (see vmax)
+template <class FIELD, std::size_t INPLACE, class CMAX>
+struct multi_storage
+{
+	using type = multi_list<FIELD, INPLACE>;
+};
+
+template <class FIELD, std::size_t INPLACE, std::size_t MAX>
+struct multi_storage<FIELD, INPLACE, pmax<MAX, contiguous>>
+{
+	static_assert(ARelocatable<FIELD>, "CONTIGUOUS STORAGE NEEDS RELOCATABLE FIELD");
+	using type = multi_vector<FIELD, INPLACE, MAX>;
+};
+
+template <class FIELD, std::size_t INPLACE, class CMAX>
+using multi_storage_t = typename multi_storage<FIELD, INPLACE, CMAX>::type;
+
+} //end: namespace detail
+
+/**
+ * Multi-instance field: the storage is linked list by default or contiguous
+ * with indexed access once opted in by vmax for relocatable fields (e.g. values
+ * and strings) which don't need stable addresses of the instances.
+ */
+template <AField FIELD, std::size_t MIN, class CMAX, class META_INFO = void, class... FIELD_META_INFO>
+class multi_field
+	: public detail::define_meta_info<META_INFO>
+	, public detail::multi_storage_t<field_t<FIELD, FIELD_META_INFO...>, detail::get_inplace<MIN, CMAX>::value, CMAX>
+{
+	static_assert(MIN > 0, "MIN SHOULD BE GREATER ZERO");
+	static_assert(CMAX::value >= MIN, "MAX SHOULD BE GREATER OR EQUAL TO MIN");
+
+	using base_t = detail::multi_storage_t<field_t<FIELD, FIELD_META_INFO...>, detail::get_inplace<MIN, CMAX>::value, CMAX>;
+
+public:
+	using ie_type = typename FIELD::ie_type;
+	using field_type = field_t<FIELD, FIELD_META_INFO...>;
+
+	static constexpr std::size_t min = MIN;
+	static constexpr std::size_t max = CMAX::value;
+	static constexpr std::size_t inplace = detail::get_inplace<MIN, CMAX>::value;
+
+	multi_field(multi_field const&) = delete;
+	multi_field& operator= (multi_field const&) = delete;
+	multi_field() = default;
+
+	bool is_set() const                                     { return not this->empty() && this->first()->is_set(); }
+
+	/**
+	 * Takes over the instances of other multi-field w/o copying the ones in
+	 * external storage: nested containers are moved (see container::move_from)
+	 * and the rest is copied.
+	 * @param from multi-field to take the instances from, left empty
+	 * @param args optional allocator or context to copy the instances with
+	 */
+	template <class... ARGS>
+	void splice(multi_field& from, ARGS&&... args)
+	{
+		base_t::splice(from, [&args...](field_type& to, field_type& src)
+		{
+			if constexpr (requires { to.move_from(src, args...); }) { to.move_from(src, args...); }
+			else { to.copy(src, args...); }
+		});
+	}
+
+	bool operator==(multi_field const& rhs) const noexcept
+	{
+		return this->count() == rhs.count() && std::equal(this->begin(), this->end(), rhs.begin());
+	}
 };
 
 }	//end: namespace med
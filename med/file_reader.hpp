@@ -0,0 +1,185 @@
+/**
+@file
+bulk reading of encoded records from memory-mapped file
+
+@copyright Denis Priyomov 2016-2017
+Distributed under the MIT License
+(See accompanying file LICENSE or visit https://github.com/cppden/med)
+*/
+
+#pragma once
+
+#include <span>
+#include <thread>
+#include <vector>
+#ifndef MED_NO_EXCEPTION
+#include <exception>
+#endif
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "framer.hpp"
+
+namespace med {
+
+/**
+ * Reads the file of records (e.g. CDRs or captured messages) concatenated
+ * back-to-back by mapping it into memory and framing the records by the tag
+ * and length in meta-info of MSG (see framer). The records are decoded in
+ * place so the external octet strings (e.g. octets_var_extern) refer into the
+ * mapping and stay valid until the file is closed.
+ * The records can be decoded in parallel: the file is split at the record
+ * boundaries closest to equal parts and each part is decoded in own thread.
+ * @tparam MSG record with the framing meta-info
+ * @tparam DECODER decoder to use for the records
+ * @tparam DEC_CTX context for the decoder
+ */
+template <class MSG, template <class> class DECODER = octet_decoder, class DEC_CTX = decoder_context<>>
+class file_reader
+{
+public:
+	using record_type = typename framer<MSG, DECODER, DEC_CTX>::frame_type;
+
+	file_reader() = default;
+	~file_reader()                                 { close(); }
+
+	/**
+	 * Maps the file to read
+	 * @param path name of the file
+	 * @return false if the file can't be mapped (see errno)
+	 */
+	bool open(char const* path)
+	{
+		close();
+		int const fd = ::open(path, O_RDONLY);
+		if (fd < 0) { return false; }
+
+		struct stat st;
+		bool ok = (0 == ::fstat(fd, &st));
+		if (ok && st.st_size > 0)
+		{
+			void* p = ::mmap(nullptr, std::size_t(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+			if (MAP_FAILED != p)
+			{
+				::madvise(p, std::size_t(st.st_size), MADV_SEQUENTIAL);
+				m_data = static_cast<uint8_t const*>(p);
+				m_size = std::size_t(st.st_size);
+			}
+			else { ok = false; }
+		}
+		::close(fd);
+		return ok;
+	}
+
+	void close() noexcept
+	{
+		if (m_data) { ::munmap(const_cast<uint8_t*>(m_data), m_size); }
+		m_data = nullptr;
+		m_size = 0;
+	}
+
+	//content of the file mapped
+	std::span<uint8_t const> data() const noexcept { return {m_data, m_size}; }
+
+	/**
+	 * Decodes the records one by one
+	 * @param ctx context to decode with, its allocator (if any) is released per record
+	 * @param func functor called as func(MSG&, record_type) for each record decoded
+	 * @return number of records or 0 on error w/o exceptions (see get_error_ctx)
+	 * NOTE: truncated record at the end of file is reported as overflow
+	 */
+	template <class FUNC>
+	std::size_t for_each(DEC_CTX& ctx, FUNC&& func)
+	{
+		return decode_part(ctx, 0, m_size, func);
+	}
+
+	/**
+	 * Decodes the records in parallel by the threads each using own context
+	 * @param ctxs contexts to decode with, one per thread (incl. the calling one)
+	 * @param func functor called concurrently as func(MSG&, record_type)
+	 * @return number of records or 0 on error w/o exceptions (see get_error_ctx)
+	 * NOTE: the 1st exception thrown by the threads is rethrown after all are done
+	 */
+	template <class FUNC>
+	std::size_t for_each(std::span<DEC_CTX> ctxs, FUNC&& func)
+	{
+		std::size_t const num = ctxs.size();
+		if (num < 2) { return num ? for_each(ctxs[0], func) : 0; }
+
+		//the splitting pass reads the record headers only
+		std::vector<std::size_t> cuts{0};
+		framer<MSG, DECODER, DEC_CTX> fr{ctxs[0]};
+		fr.reset(m_data, m_size);
+		for (std::size_t i = 1; i < num; ++i)
+		{
+			auto const part = m_size / num * i;
+			while (fr.offset() < part && not fr.next().empty()) {}
+			cuts.push_back(fr.offset());
+		}
+		cuts.push_back(m_size);
+
+		std::vector<std::size_t> counts(num);
+#ifndef MED_NO_EXCEPTION
+		std::vector<std::exception_ptr> errors(num);
+#endif
+		auto run = [&](std::size_t i)
+		{
+#ifdef MED_NO_EXCEPTION
+			counts[i] = decode_part(ctxs[i], cuts[i], cuts[i + 1], func);
+#else
+			try { counts[i] = decode_part(ctxs[i], cuts[i], cuts[i + 1], func); }
+			catch (...) { errors[i] = std::current_exception(); }
+#endif
+		};
+
+		std::vector<std::thread> threads;
+		threads.reserve(num - 1);
+		for (std::size_t i = 1; i < num; ++i) { threads.emplace_back(run, i); }
+		run(0);
+		for (auto& t : threads) { t.join(); }
+
+		std::size_t total = 0;
+		for (std::size_t i = 0; i < num; ++i)
+		{
+#ifdef MED_NO_EXCEPTION
+			if (get_error_ctx(ctxs[i])) { return 0; }
+#else
+			if (errors[i]) { std::rethrow_exception(errors[i]); }
+#endif
+			total += counts[i];
+		}
+		return total;
+	}
+
+private:
+	file_reader(file_reader const&) = delete;
+	file_reader& operator=(file_reader const&) = delete;
+
+	template <class FUNC>
+	std::size_t decode_part(DEC_CTX& ctx, std::size_t from, std::size_t to, FUNC& func)
+	{
+		framer<MSG, DECODER, DEC_CTX> fr{ctx};
+		fr.reset(m_data + from, to - from);
+		std::size_t count = 0;
+		for (auto record : fr)
+		{
+			if constexpr (requires { get_allocator(ctx).release(); }) { get_allocator(ctx).release(); }
+			MSG msg;
+			MED_CHECK_FAIL(fr.decode(msg));
+			func(msg, record);
+			++count;
+		}
+		MED_RETURN_ON_ERROR(ctx);
+		if (fr.need()) { MED_THROW_EXCEPTION(overflow, name<MSG>(), fr.need(), ctx) }
+		return count;
+	}
+
+	uint8_t const* m_data{nullptr};
+	std::size_t    m_size{0};
+};
+
+} //namespace med
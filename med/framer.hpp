@@ -0,0 +1,206 @@
+/**
+@file
+framing of messages concatenated in the same buffer
+
+@copyright Denis Priyomov 2016-2017
+Distributed under the MIT License
+(See accompanying file LICENSE or visit https://github.com/cppden/med)
+*/
+
+#pragma once
+
+#include <iterator>
+#include <limits>
+#include <span>
+
+#include "decoder_context.hpp"
+#include "octet_decoder.hpp"
+#include "decode.hpp"
+
+namespace med {
+
+/**
+ * Splits the data received (e.g. from TCP stream) into messages which follow
+ * each other back-to-back. The boundary of each message is located by the tag
+ * and length of its meta-info (e.g. version and length of Diameter message)
+ * w/o decoding the body so the frames can be handed over or decoded later.
+ * The frames are iterated by next() or range-for and the consumed offset tells
+ * how much of the buffer can be compacted when the last message is incomplete.
+ * NOTE: the length is expected in meta-info of MSG (see add_len) and to cover
+ *       the rest of message after it.
+ * NOTE: the message longer than max size given is invalid_value error rather
+ *       than the octets to wait for (e.g. to drop the peer sending garbage).
+ * @tparam MSG message with the framing meta-info
+ * @tparam DECODER decoder to use for the framing and messages
+ * @tparam DEC_CTX context for the decoder
+ */
+template <class MSG, template <class> class DECODER = octet_decoder, class DEC_CTX = decoder_context<>>
+class framer
+{
+public:
+	using pointer = typename DEC_CTX::buffer_type::pointer;
+	using frame_type = std::span<std::remove_pointer_t<pointer>>;
+
+	/**
+	 * @param ctx context to decode with
+	 * @param max_size max size of message in octets
+	 */
+	explicit framer(DEC_CTX& ctx, std::size_t max_size = std::numeric_limits<std::size_t>::max()) noexcept
+		: m_ctx{ctx}, m_max_size{max_size} {}
+
+	DEC_CTX& get_context() noexcept                { return m_ctx; }
+
+	//starts with the data received so far
+	void reset(void const* p, std::size_t size) noexcept
+	{
+		m_data = static_cast<pointer>(p);
+		m_size = size;
+		m_offset = 0;
+		m_need = 0;
+		m_frame = {};
+	}
+	template <typename T, std::size_t SIZE>
+	void reset(T const (&p)[SIZE]) noexcept        { reset(p, sizeof(p)); }
+
+	//more data received right after the data passed before
+	void append(std::size_t size) noexcept
+	{
+		m_size += size;
+		m_need = (m_need > size) ? m_need - size : 0;
+	}
+
+	//minimum number of octets to receive to complete the next message
+	std::size_t need() const noexcept              { return m_need; }
+	//number of octets occupied by the messages framed so far
+	std::size_t offset() const noexcept            { return m_offset; }
+	//message located by last next() or empty
+	frame_type frame() const noexcept              { return m_frame; }
+
+	/**
+	 * Locates the next message after the last one
+	 * @return the message octets or empty if more data is needed
+	 * NOTE: w/o exceptions empty is also returned on error (see get_error_ctx)
+	 */
+	frame_type next()
+	{
+		m_frame = {};
+		if (m_need) { return m_frame; } //no chance to progress
+
+		std::size_t const left = m_size - m_offset;
+		if (0 == left) { return m_frame; }
+		m_ctx.reset(m_data + m_offset, left);
+		DECODER<DEC_CTX> decoder{m_ctx};
+		std::size_t size = 0;
+#ifdef MED_NO_EXCEPTION
+		size = frame_size<meta::produce_info_t<DECODER<DEC_CTX>, MSG>>(decoder);
+		if (auto& err = m_ctx.buffer().error_ctx(); err)
+		{
+			if (err.get_error() == error::overflow && partial(err.offset(), err.value(0))) { err.reset(); }
+			return m_frame;
+		}
+#else
+		try
+		{
+			size = frame_size<meta::produce_info_t<DECODER<DEC_CTX>, MSG>>(decoder);
+		}
+		catch (overflow const& ex)
+		{
+			if (not partial(ex.offset(), ex.bytes())) { throw; }
+			return m_frame;
+		}
+#endif
+		if (partial(0, size)) { return m_frame; }
+
+		CODEC_TRACE("frame[%s] %zu octets at %zu", name<MSG>(), size, m_offset);
+		m_frame = {m_data + m_offset, size};
+		m_offset += size;
+		m_ctx.reset(m_frame.data(), m_frame.size());
+		return m_frame;
+	}
+
+	/**
+	 * Decodes the message located by last next()
+	 * @param msg message to decode into
+	 */
+	template <class IE>
+	MED_RESULT decode(IE& msg)
+	{
+		m_ctx.reset(m_frame.data(), m_frame.size());
+		return med::decode(DECODER<DEC_CTX>{m_ctx}, msg);
+	}
+
+	//input iterator over the messages located one by one
+	class iterator
+	{
+	public:
+		using difference_type = std::ptrdiff_t;
+		using value_type = frame_type;
+
+		iterator() = default;
+		explicit iterator(framer& f) noexcept : m_framer{&f} {}
+
+		frame_type operator*() const noexcept      { return m_framer->frame(); }
+		iterator& operator++()                     { m_framer->next(); return *this; }
+		void operator++(int)                       { ++*this; }
+		bool operator==(std::default_sentinel_t) const noexcept { return m_framer->frame().empty(); }
+
+	private:
+		framer* m_framer{nullptr};
+	};
+
+	//continues from the consumed offset
+	iterator begin()                               { next(); return iterator{*this}; }
+	std::default_sentinel_t end() const noexcept   { return {}; }
+
+private:
+	framer(framer const&) = delete;
+	framer& operator=(framer const&) = delete;
+
+	//size of message from its tags and length in meta-info
+	template <class META_INFO>
+	std::size_t frame_size(DECODER<DEC_CTX>& decoder)
+	{
+		static_assert(not meta::list_is_empty_v<META_INFO>, "LENGTH IN META-INFO IS EXPECTED");
+		using mi = meta::list_first_t<META_INFO>;
+		using info_t = get_info_t<mi>;
+
+		if constexpr (mi::kind == mik::LEN)
+		{
+			static_assert(std::is_void_v<get_dependency_t<info_t>>, "LENGTH DEPENDENCY IS NOT SUPPORTED");
+			auto const len = sl::decode_len<info_t>(decoder);
+			MED_RETURN_ON_ERROR(decoder);
+			auto const size = m_ctx.buffer().get_offset() + len;
+			if (size > m_max_size) { MED_THROW_EXCEPTION(invalid_value, name<MSG>(), size, decoder) }
+			return size;
+		}
+		else
+		{
+			auto const tag = sl::decode_tag<info_t>(decoder);
+			MED_RETURN_ON_ERROR(decoder);
+			if (not info_t::match(tag)) { MED_THROW_EXCEPTION(unknown_tag, name<MSG>(), tag, decoder) }
+			return frame_size<meta::list_rest_t<META_INFO>>(decoder);
+		}
+	}
+
+	//data received is short of the octets at the offset given
+	bool partial(std::size_t ofs, std::size_t bytes) noexcept
+	{
+		std::size_t const left = m_size - m_offset;
+		if (ofs + bytes > left)
+		{
+			m_need = ofs + bytes - left;
+			return true;
+		}
+		return false;
+	}
+
+	DEC_CTX&    m_ctx;
+	std::size_t const m_max_size;
+	pointer     m_data{nullptr};
+	std::size_t m_size{0};
+	std::size_t m_offset{0};
+	std::size_t m_need{0};
+	frame_type  m_frame{};
+};
+
+} //namespace med
@@ -0,0 +1,122 @@
+/**
+@file
+scatter-gather buffer for encoding into a chain of iovec
+
+@copyright Denis Priyomov 2016-2017
+Distributed under the MIT License
+(See accompanying file LICENSE or visit https://github.com/cppden/med)
+*/
+
+#pragma once
+
+#include <sys/uio.h>
+
+#include "buffer.hpp"
+
+namespace med {
+
+/**
+ * Encoder buffer which refers large external octet strings in place.
+ * Everything else is written into the contiguous memory as usual while the
+ * output is described by iovec chain (see iov) to be passed to writev/sendmsg.
+ * The data referred should outlive the output.
+ * @tparam MAX_IOV max number of iovec in the chain, extra strings are copied
+ * @tparam MIN_GATHER min size of string to refer, smaller ones are copied
+ */
+template <std::size_t MAX_IOV = 16, std::size_t MIN_GATHER = 128>
+class iovec_buffer : public buffer<uint8_t>
+{
+	using base_t = buffer<uint8_t>;
+	static_assert(MAX_IOV >= 3, "AT LEAST 3 SEGMENTS TO GATHER");
+
+public:
+	//state accounting for the octets referred so lengths and padding are intact
+	//and the chain is restored along with the buffer (e.g. to roll back)
+	class state_type : public base_t::state_type
+	{
+	public:
+		constexpr state_type() = default;
+
+		friend constexpr std::ptrdiff_t operator- (state_type const& rhs, state_type const& lhs)
+		{
+			return (pointer(rhs) - pointer(lhs)) + std::ptrdiff_t(rhs.m_gathered - lhs.m_gathered);
+		}
+
+	private:
+		friend class iovec_buffer;
+		constexpr state_type(base_t::state_type const& st, pointer segment, std::size_t count, std::size_t gathered)
+			: base_t::state_type{st}, m_segment{segment}, m_count{count}, m_gathered{gathered} {}
+
+		pointer     m_segment{nullptr};
+		std::size_t m_count{0};
+		std::size_t m_gathered{0};
+	};
+
+	template <typename... Ts>
+	constexpr void reset(Ts&&... args) noexcept
+	{
+		base_t::reset(std::forward<Ts>(args)...);
+		m_segment = begin();
+		m_count = 0;
+		m_gathered = 0;
+	}
+
+	constexpr state_type get_state() const noexcept
+	{
+		return state_type{base_t::get_state(), m_segment, m_count, m_gathered};
+	}
+	constexpr void set_state(state_type const& st) noexcept
+	{
+		base_t::set_state(st);
+		m_segment = st.m_segment;
+		m_count = st.m_count;
+		m_gathered = st.m_gathered;
+	}
+
+	/**
+	 * Refers the external data instead of copying
+	 * @return false if data should be copied
+	 */
+	constexpr bool gather(void const* p, std::size_t size) noexcept
+	{
+		//the segment before, the one referred and the rest
+		if (size < MIN_GATHER || m_count + 3 > MAX_IOV) { return false; }
+
+		close_segment();
+		m_iov[m_count++] = iovec{const_cast<void*>(p), size};
+		m_gathered += size;
+		CODEC_TRACE("gather #%zu: %zu octets", m_count, size);
+		return true;
+	}
+
+	//output as chain of iovec
+	std::span<iovec const> iov() noexcept
+	{
+		auto num = m_count;
+		if (begin() > m_segment)
+		{
+			m_iov[num++] = iovec{m_segment, std::size_t(begin() - m_segment)};
+		}
+		return {m_iov, num};
+	}
+
+	//total number of octets in the output
+	constexpr std::size_t total_size() const noexcept   { return get_offset() + m_gathered; }
+
+private:
+	constexpr void close_segment() noexcept
+	{
+		if (begin() > m_segment)
+		{
+			m_iov[m_count++] = iovec{m_segment, std::size_t(begin() - m_segment)};
+		}
+		m_segment = begin();
+	}
+
+	pointer     m_segment{nullptr}; //start of the current segment in the buffer
+	std::size_t m_count{0};
+	std::size_t m_gathered{0};
+	iovec       m_iov[MAX_IOV];
+};
+
+} //namespace med
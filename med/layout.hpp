@@ -0,0 +1,167 @@
+/**
+@file
+compile-time layout of leading fixed-size fields of sequence
+
+@copyright Denis Priyomov 2016-2017
+Distributed under the MIT License
+(See accompanying file LICENSE or visit https://github.com/cppden/med)
+*/
+
+#pragma once
+
+#include <bit>
+#include <cstring>
+
+#include "bytes.hpp"
+#include "concepts.hpp"
+#include "ie_type.hpp"
+#include "snapshot.hpp"
+#include "traits.hpp"
+#include "meta/typelist.hpp"
+
+namespace med {
+
+namespace detail {
+
+//IE encoded at the same offset with the same size in any message
+template <class IE, class FIELD = get_field_type_t<IE>>
+concept AFixedLayout = AMandatory<IE> && !AMultiField<IE> && AEmptyTypeList<get_meta_info_t<IE>>
+	&& std::is_same_v<IE_VALUE, typename FIELD::ie_type> && AIeValue<FIELD>
+	&& FIELD::traits::offset == 0 && FIELD::traits::bits % 8 == 0;
+
+struct is_not_fixed_layout
+{
+	template <class IE>
+	static constexpr bool value = !AFixedLayout<IE>;
+};
+
+//IE of fixed layout coded as is i.e. w/o setter, length or snapshot
+template <class IE>
+concept AFixedRun = !std::is_void_v<IE> && AFixedLayout<IE> && !AHasSetterType<IE> && !AHasSetLength<IE>
+	&& !std::is_base_of_v<with_snapshot, get_field_type_t<IE>>;
+
+template <std::size_t N, class T>
+constexpr bool is_native_load_v = std::is_unsigned_v<T> && sizeof(T) == N && (N == 1 || N == 2 || N == 4 || N == 8);
+
+template <class T>
+constexpr T byteswap(T v)
+{
+	if constexpr (sizeof(T) == 1 || std::endian::native == std::endian::big) { return v; }
+	else if constexpr (sizeof(T) == 2) { return __builtin_bswap16(v); }
+	else if constexpr (sizeof(T) == 4) { return __builtin_bswap32(v); }
+	else { return __builtin_bswap64(v); }
+}
+
+} //end: namespace detail
+
+/**
+ * Reads N octets in network order
+ * NOTE: unlike get_bytes the native sizes are loaded at once and byte-swapped
+ */
+template <std::size_t N, typename T>
+inline T load_bytes(uint8_t const* in)
+{
+	if constexpr (detail::is_native_load_v<N, T>)
+	{
+		T v;
+		std::memcpy(&v, in, N);
+		return detail::byteswap(v);
+	}
+	else
+	{
+		return get_bytes<N, T>(in);
+	}
+}
+
+//writes N octets in network order
+template <std::size_t N, typename T>
+inline void store_bytes(T v, uint8_t* out)
+{
+	if constexpr (detail::is_native_load_v<N, T>)
+	{
+		v = detail::byteswap(v);
+		std::memcpy(out, &v, N);
+	}
+	else
+	{
+		put_bytes<N>(std::size_t(v), out);
+	}
+}
+
+/**
+ * Offsets of the leading IEs of sequence which are mandatory values of fixed
+ * size w/o tag or length (e.g. fields of a protocol header) so their position
+ * in the encoded message is known at compile-time.
+ * @tparam MSG sequence
+ */
+template <class MSG>
+struct fixed_layout
+{
+	//leading IEs of fixed layout
+	using ies_types = meta::list_before_t<typename MSG::ies_types, detail::is_not_fixed_layout>;
+
+	//IE is in the fixed part
+	template <class FIELD>
+	static constexpr bool has = []<class... IEs>(meta::typelist<IEs...>*)
+	{
+		return (std::is_same_v<FIELD, get_field_type_t<IEs>> || ...);
+	}(static_cast<ies_types*>(nullptr));
+
+	//encoded size of IE
+	template <class FIELD>
+	static constexpr std::size_t width = FIELD::traits::bits / 8;
+
+	//offset of IE from the start of message
+	template <class FIELD> requires has<FIELD>
+	static constexpr std::size_t offset = []<class... IEs>(meta::typelist<IEs...>*)
+	{
+		std::size_t ofs = 0;
+		bool found = false;
+		((found = found || std::is_same_v<FIELD, get_field_type_t<IEs>>, ofs += found ? 0 : width<get_field_type_t<IEs>>), ...);
+		return ofs;
+	}(static_cast<ies_types*>(nullptr));
+
+	//size of the fixed part
+	static constexpr std::size_t size = []<class... IEs>(meta::typelist<IEs...>*)
+	{
+		return (std::size_t(0) + ... + width<get_field_type_t<IEs>>);
+	}(static_cast<ies_types*>(nullptr));
+};
+
+namespace sl {
+
+/**
+ * Size of the run of consecutive fixed-size IEs (see AFixedRun) starting from IE
+ * in the list so the space is checked once for the whole run which is then
+ * coded w/o checks.
+ * @return size in octets or 0 if IE doesn't start the run of 2 IEs at least
+ */
+template <class IE, class IE_LIST>
+constexpr std::size_t fixed_run_size = []<class... IEs>(meta::typelist<IEs...>*)
+{
+	std::size_t size = 0, count = 0;
+	bool in_run = false, stop = false;
+	([&]
+	{
+		in_run = in_run || std::is_same_v<IE, IEs>;
+		if (not in_run || stop) { return; }
+		if constexpr (detail::AFixedRun<IEs>)
+		{
+			size += get_field_type_t<IEs>::traits::bits / 8;
+			++count;
+		}
+		else { stop = true; }
+	}(), ...);
+	return count > 1 ? size : 0;
+}(static_cast<IE_LIST*>(nullptr));
+
+//IE follows PREV_IE in the run of fixed-size IEs so the space is checked already
+template <class PREV_IE, class IE, class IE_LIST>
+constexpr bool in_fixed_run = false;
+template <detail::AFixedRun PREV_IE, detail::AFixedRun IE, class IE_LIST>
+constexpr bool in_fixed_run<PREV_IE, IE, IE_LIST> =
+	meta::list_index_of_v<PREV_IE, IE_LIST> + 1 == meta::list_index_of_v<IE, IE_LIST>;
+
+} //end: namespace sl
+
+}	//end: namespace med
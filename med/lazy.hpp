@@ -0,0 +1,106 @@
+/**
+@file
+IE decoded on demand from the octets it occupies
+
+@copyright Denis Priyomov 2016-2017
+Distributed under the MIT License
+(See accompanying file LICENSE or visit https://github.com/cppden/med)
+*/
+
+#pragma once
+
+#include "octet_string.hpp"
+#include "decoder_context.hpp"
+#include "octet_decoder.hpp"
+#include "decode.hpp"
+
+namespace med {
+
+/**
+ * Wrapper to defer decoding of IE until it's accessed.
+ * The message decoding validates the framing (tag and length) and records
+ * the octets of IE only, so unaccessed IEs cost the skip over. The IE is
+ * decoded from these octets on first get() and is encoded back as is, which
+ * suits forwarding of the message without changes.
+ * NOTE: the octets are referred in place so the decoded buffer should outlive
+ *       the wrapper; the IE is bounded by the length (e.g. M<T, L, lazy<IE>>
+ *       or add_len of IE) or occupies the rest of the message.
+ * @tparam FIELD the IE wrapped
+ * @tparam DECODER decoder to use for the IE
+ * @tparam DEC_CTX context for the decoder (its allocator is not available)
+ */
+template <class FIELD, template <class> class DECODER = octet_decoder, class DEC_CTX = decoder_context<>>
+class lazy : public octet_string<>
+{
+	using base_t = octet_string<>;
+
+public:
+	using ie_wrapped = FIELD;
+	using meta_info = get_meta_info_t<FIELD>;
+
+	static constexpr char const* name()         { return med::name<FIELD>(); }
+
+	lazy() = default;
+	lazy(lazy const&) = delete;
+	lazy& operator= (lazy const&) = delete;
+
+	//IE was decoded from its octets already
+	bool decoded() const                        { return m_decoded; }
+
+	/**
+	 * Decodes the IE on first access (again after failed one)
+	 * @return the IE or nullptr if not present (or failed w/o exceptions)
+	 */
+	FIELD const* get() const
+	{
+		if (not m_decoded && is_set())
+		{
+			CODEC_TRACE("lazy[%s] %zu octets", name(), size());
+			//leftovers of failed access
+			m_ie.clear();
+			DEC_CTX ctx{data(), size()};
+			DECODER<DEC_CTX> decoder{ctx};
+#ifdef MED_NO_EXCEPTION
+			if (not sl::ie_decode<type_context<typename FIELD::ie_type>>(decoder, m_ie))
+			{
+				m_ie.clear();
+				return nullptr;
+			}
+#else
+			sl::ie_decode<type_context<typename FIELD::ie_type>>(decoder, m_ie);
+#endif
+			m_decoded = true;
+		}
+		return m_decoded ? &m_ie : nullptr;
+	}
+
+	void clear()
+	{
+		base_t::clear();
+		m_ie.clear();
+		m_decoded = false;
+	}
+
+	template <class... ARGS>
+	void copy(lazy const& from, ARGS&&... args)
+	{
+		clear();
+		base_t::copy(from, std::forward<ARGS>(args)...);
+	}
+
+	bool set_encoded(std::size_t len, void const* data)
+	{
+		if (m_decoded)
+		{
+			m_ie.clear();
+			m_decoded = false;
+		}
+		return base_t::set_encoded(len, data);
+	}
+
+private:
+	mutable FIELD m_ie;
+	mutable bool  m_decoded{false};
+};
+
+}	//end: namespace med
@@ -94,7 +94,11 @@ constexpr std::size_t ie_length(IE const& ie, ENCODER& encoder) noexcept
 	else //data itself
 	{
 		CODEC_TRACE("%s[%s]<%s:%s> - DATA", __FUNCTION__, name<IE>(), name<EXP_TAG>(), name<EXP_LEN>());
-		if constexpr (AContainer<IE>)
+		if constexpr (ACold<IE>)
+		{
+			len += ie_length<TYPE_CTX>(*ie.get(), encoder);
+		}
+		else if constexpr (AContainer<IE>)
 		{
 			using ctx = type_context<typename TYPE_CTX::ie_type, meta::typelist<>, EXP_TAG, EXP_LEN>;
 			CODEC_TRACE("%s[%.30s]%s<%s:%s>: %s", __FUNCTION__, name<IE>(), AMultiField<IE>?"*":"", name<EXP_TAG>(), name<EXP_LEN>(), name<typename IE::ie_type>());
@@ -130,8 +134,8 @@ constexpr std::size_t field_length(IE const& ie, ENCODER& encoder) noexcept
 }
 
 
-template <AField FIELD>
-constexpr void length_to_value(FIELD& field, std::size_t len)
+template <AField FIELD, class FUNC>
+constexpr MED_RESULT length_to_value(FUNC& func, FIELD& field, std::size_t len)
 {
 	//set the length IE with the value
 	if constexpr (AHasSetLength<FIELD>)
@@ -140,7 +144,7 @@ constexpr void length_to_value(FIELD& field, std::size_t len)
 		{
 			if (not field.set_length(len))
 			{
-				MED_THROW_EXCEPTION(invalid_value, name<FIELD>(), len)
+				MED_THROW_EXCEPTION(invalid_value, name<FIELD>(), len, func)
 			}
 		}
 		else
@@ -152,7 +156,7 @@ constexpr void length_to_value(FIELD& field, std::size_t len)
 	{
 		if (not field.set_encoded(len))
 		{
-			MED_THROW_EXCEPTION(invalid_value, name<FIELD>(), len)
+			MED_THROW_EXCEPTION(invalid_value, name<FIELD>(), len, func)
 		}
 	}
 	else
@@ -160,6 +164,7 @@ constexpr void length_to_value(FIELD& field, std::size_t len)
 		field.set_encoded(len);
 	}
 	CODEC_TRACE("L=%zXh(%zX) [%s]:", len, std::size_t(field.get_encoded()), name<FIELD>());
+	MED_RETURN_SUCCESS;
 }
 
 template <class FIELD>
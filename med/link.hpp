@@ -0,0 +1,75 @@
+/**
+@file
+self-relative link to keep message relocatable
+
+@copyright Denis Priyomov 2016-2017
+Distributed under the MIT License
+(See accompanying file LICENSE or visit https://github.com/cppden/med)
+*/
+
+#pragma once
+
+#include <bit>
+#include <cassert>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+
+#include "config.hpp"
+
+namespace med {
+
+/**
+ * Pointer stored as offset of the target from the link itself so the message
+ * and its allocations (e.g. decoded into the same arena) stay valid when copied
+ * as a whole by memcpy or mapped at another address (e.g. shared memory).
+ * NOTE: the target is to be within the range of OFFSET from the link: see reaches()
+ *       to check it before the target is linked (e.g. on allocation or decode)
+ * NOTE: octet strings with external storage are linked into the encoded data
+ *       which is to be moved along (see MED_EXTERN_LINK_OFFSET)
+ * @tparam T type of the target
+ * @tparam OFFSET signed integer to store the offset (see MED_LINK_OFFSET)
+ */
+template <class T, class OFFSET = MED_LINK_OFFSET>
+class link
+{
+public:
+	using offset_type = OFFSET;
+	static_assert(std::is_signed_v<offset_type>, "SIGNED OFFSET IS EXPECTED");
+
+	link() = default;
+	explicit link(T* p) noexcept                { set(p); }
+	//copy refers to the same target
+	link(link const& rhs) noexcept              { set(rhs.get()); }
+	link& operator=(link const& rhs) noexcept   { set(rhs.get()); return *this; }
+	link& operator=(T* p) noexcept              { set(p); return *this; }
+
+	T* get() const noexcept
+	{
+		return m_ofs ? std::bit_cast<T*>(std::bit_cast<std::uintptr_t>(this) + std::uintptr_t(m_ofs)) : nullptr;
+	}
+	operator T*() const noexcept                { return get(); }
+	T* operator->() const noexcept              { return get(); }
+	T& operator*() const noexcept               { return *get(); }
+
+	//target can be linked from here
+	bool reaches(T const* p) const noexcept     { return std::in_range<offset_type>(offset(p)); }
+
+private:
+	//NOTE: link never refers to itself so zero offset is null
+	std::intptr_t offset(T const* p) const noexcept
+	{
+		return p ? std::intptr_t(std::bit_cast<std::uintptr_t>(p) - std::bit_cast<std::uintptr_t>(this)) : 0;
+	}
+
+	void set(T* p) noexcept
+	{
+		std::intptr_t const ofs = offset(p);
+		assert(std::in_range<offset_type>(ofs) && "TARGET IS OUT OF LINK RANGE");
+		m_ofs = offset_type(ofs);
+	}
+
+	offset_type m_ofs {0};
+};
+
+}	//end: namespace med
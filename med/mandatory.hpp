@@ -84,14 +84,14 @@ struct mandatory<
 };
 
 //M<FIELD, min<MIN>, Pmax<MAX>, CNT_GETTER>
-template <AField FIELD, std::size_t MIN, std::size_t MAX, ACountGetter COUNTER>
+template <AField FIELD, std::size_t MIN, std::size_t MAX, ACountGetter COUNTER, class STORAGE>
 struct mandatory<
 	FIELD,
 	min<MIN>,
-	pmax<MAX>,
+	pmax<MAX, STORAGE>,
 	COUNTER,
 	max<1>
-> : multi_field<FIELD, MIN, pmax<MAX>>
+> : multi_field<FIELD, MIN, pmax<MAX, STORAGE>>
 {
 	using count_getter = COUNTER;
 	static_assert(MIN > 1, "MIN SHOULD BE MORE THAN 1 OR NOT SPECIFIED");
@@ -113,14 +113,14 @@ struct mandatory<
 };
 
 //M<CNT, FIELD, min<MIN>, Pmax<MAX>>
-template <ACounter COUNTER, AField FIELD, std::size_t MIN, std::size_t MAX>
+template <ACounter COUNTER, AField FIELD, std::size_t MIN, std::size_t MAX, class STORAGE>
 struct mandatory<
 	COUNTER,
 	FIELD,
 	min<MIN>,
-	pmax<MAX>,
+	pmax<MAX, STORAGE>,
 	max<1>
-> : multi_field<FIELD, MIN, pmax<MAX>>, COUNTER
+> : multi_field<FIELD, MIN, pmax<MAX, STORAGE>>, COUNTER
 {
 	static_assert(MIN > 1, "MIN SHOULD BE MORE THAN 1 OR NOT SPECIFIED");
 	static_assert(MAX > MIN, "MAX SHOULD BE MORE THAN MIN");
@@ -141,14 +141,14 @@ struct mandatory<
 };
 
 //M<FIELD, min<MIN>, Pmax<MAX>>
-template <AField FIELD, std::size_t MIN, std::size_t MAX>
+template <AField FIELD, std::size_t MIN, std::size_t MAX, class STORAGE>
 struct mandatory<
 	FIELD,
 	min<MIN>,
-	pmax<MAX>,
+	pmax<MAX, STORAGE>,
 	min<1>,
 	max<1>
-> : multi_field<FIELD, MIN, pmax<MAX>>
+> : multi_field<FIELD, MIN, pmax<MAX, STORAGE>>
 {
 	static_assert(MIN > 1, "MIN SHOULD BE MORE THAN 1 OR NOT SPECIFIED");
 	static_assert(MAX > MIN, "MAX SHOULD BE MORE THAN MIN");
@@ -168,14 +168,14 @@ struct mandatory<
 };
 
 //M<FIELD, Pmax<MAX>>
-template <AField FIELD, std::size_t MAX>
+template <AField FIELD, std::size_t MAX, class STORAGE>
 struct mandatory<
 	FIELD,
-	pmax<MAX>,
+	pmax<MAX, STORAGE>,
 	void,
 	min<1>,
 	max<1>
-> : multi_field<FIELD, 1, pmax<MAX>>
+> : multi_field<FIELD, 1, pmax<MAX, STORAGE>>
 {
 	static_assert(MAX > 1, "MAX SHOULD BE MORE THAN 1 OR NOT SPECIFIED");
 };
@@ -195,14 +195,14 @@ struct mandatory<
 };
 
 //M<FIELD, Pmax<MAX>, COUNTER>
-template <AField FIELD, std::size_t MAX, ACountGetter COUNTER>
+template <AField FIELD, std::size_t MAX, ACountGetter COUNTER, class STORAGE>
 struct mandatory<
 	FIELD,
-	pmax<MAX>,
+	pmax<MAX, STORAGE>,
 	COUNTER,
 	min<1>,
 	max<1>
-> : multi_field<FIELD, 1, pmax<MAX>>
+> : multi_field<FIELD, 1, pmax<MAX, STORAGE>>
 {
 	using count_getter = COUNTER;
 	static_assert(MAX > 1, "MAX SHOULD BE MORE THAN 1 OR NOT SPECIFIED");
@@ -222,14 +222,14 @@ struct mandatory<
 };
 
 //M<CNT, FIELD, Pmax<MAX>>
-template <ACounter COUNTER, AField FIELD, std::size_t MAX>
+template <ACounter COUNTER, AField FIELD, std::size_t MAX, class STORAGE>
 struct mandatory<
 	COUNTER,
 	FIELD,
-	pmax<MAX>,
+	pmax<MAX, STORAGE>,
 	min<1>,
 	max<1>
-> : multi_field<FIELD, 1, pmax<MAX>>, COUNTER
+> : multi_field<FIELD, 1, pmax<MAX, STORAGE>>, COUNTER
 {
 	static_assert(MAX > 1, "MAX SHOULD BE MORE THAN 1 OR NOT SPECIFIED");
 };
@@ -286,14 +286,14 @@ struct mandatory<
 };
 
 //M<TAG, FIELD, Pmax<MAX>>
-template <ATag TAG, AField FIELD, std::size_t MAX>
+template <ATag TAG, AField FIELD, std::size_t MAX, class STORAGE>
 struct mandatory<
 	TAG,
 	FIELD,
-	pmax<MAX>,
+	pmax<MAX, STORAGE>,
 	min<1>,
 	max<1>
-> : multi_field<FIELD, 1, pmax<MAX>, void, add_tag<TAG>>
+> : multi_field<FIELD, 1, pmax<MAX, STORAGE>, void, add_tag<TAG>>
 {
 	static_assert(MAX > 1, "MAX SHOULD BE MORE THAN 1 OR NOT SPECIFIED");
 };
@@ -313,14 +313,14 @@ struct mandatory<
 };
 
 //M<TAG, FIELD, min<MIN>, Pmax<MAX>>
-template <ATag TAG, AField FIELD, std::size_t MIN, std::size_t MAX>
+template <ATag TAG, AField FIELD, std::size_t MIN, std::size_t MAX, class STORAGE>
 struct mandatory<
 	TAG,
 	FIELD,
 	min<MIN>,
-	pmax<MAX>,
+	pmax<MAX, STORAGE>,
 	max<1>
-> : multi_field<FIELD, MIN, pmax<MAX>, void, add_tag<TAG>>
+> : multi_field<FIELD, MIN, pmax<MAX, STORAGE>, void, add_tag<TAG>>
 {
 	static_assert(MIN > 1, "MIN SHOULD BE MORE THAN 1 OR NOT SPECIFIED");
 	static_assert(MAX > MIN, "MAX SHOULD BE MORE THAN MIN");
@@ -391,14 +391,14 @@ struct mandatory<
 };
 
 //M<LEN, FIELD, Pmax<MAX>>
-template <ALength LEN, AField FIELD, std::size_t MAX>
+template <ALength LEN, AField FIELD, std::size_t MAX, class STORAGE>
 struct mandatory<
 	LEN,
 	FIELD,
-	pmax<MAX>,
+	pmax<MAX, STORAGE>,
 	min<1>,
 	max<1>
-> : multi_field<FIELD, 1, pmax<MAX>, void, add_len<typename LEN::length_type>>
+> : multi_field<FIELD, 1, pmax<MAX, STORAGE>, void, add_len<typename LEN::length_type>>
 {
 	static_assert(MAX > 1, "MAX SHOULD BE MORE THAN 1 OR NOT SPECIFIED");
 };
@@ -417,14 +417,14 @@ struct mandatory<
 };
 
 //M<TAG, LEN, FIELD, Pmax<MAX>>
-template <ATag TAG, ALength LEN, AField FIELD, std::size_t MAX>
+template <ATag TAG, ALength LEN, AField FIELD, std::size_t MAX, class STORAGE>
 struct mandatory<
 	TAG,
 	LEN,
 	FIELD,
-	pmax<MAX>,
+	pmax<MAX, STORAGE>,
 	max<1>
-> : multi_field<FIELD, 1, pmax<MAX>, void, add_tag<TAG>, add_len<typename LEN::length_type>>
+> : multi_field<FIELD, 1, pmax<MAX, STORAGE>, void, add_tag<TAG>, add_len<typename LEN::length_type>>
 {
 	static_assert(MAX > 1, "MAX SHOULD BE MORE THAN 1 OR NOT SPECIFIED");
 };
@@ -444,14 +444,14 @@ struct mandatory<
 };
 
 //M<TAG, LEN, FIELD, min<MIN>, Pmax<MAX>>
-template <ATag TAG, ALength LEN, AField FIELD, std::size_t MIN, std::size_t MAX>
+template <ATag TAG, ALength LEN, AField FIELD, std::size_t MIN, std::size_t MAX, class STORAGE>
 struct mandatory<
 	TAG,
 	LEN,
 	FIELD,
 	min<MIN>,
-	pmax<MAX>
-> : multi_field<FIELD, MIN, pmax<MAX>, void, add_tag<TAG>, add_len<typename LEN::length_type>>
+	pmax<MAX, STORAGE>
+> : multi_field<FIELD, MIN, pmax<MAX, STORAGE>, void, add_tag<TAG>, add_len<typename LEN::length_type>>
 {
 	static_assert(MIN > 1, "MIN SHOULD BE MORE THAN 1 OR NOT SPECIFIED");
 	static_assert(MAX > MIN, "MAX SHOULD BE MORE THAN MIN");
@@ -20,18 +20,51 @@ template <class... Ts> struct foreach;
 template <class T0, class... Ts>
 struct foreach<T0, Ts...>
 {
+	//NOTE: non-void result of apply is treated as success indicator to stop on 1st failure
 	template <class F, class... Args>
-	static constexpr void exec(F&& f, Args&&... args)
+	static constexpr auto exec(F&& f, Args&&... args)
 	{
-		f.template apply<T0>(std::forward<Args>(args)...);
-		foreach<Ts...>::template exec(std::forward<F>(f), std::forward<Args>(args)...);
+		if constexpr (std::is_void_v<decltype(f.template apply<T0>(std::forward<Args>(args)...))>)
+		{
+			f.template apply<T0>(std::forward<Args>(args)...);
+			return foreach<Ts...>::template exec(std::forward<F>(f), std::forward<Args>(args)...);
+		}
+		else
+		{
+			auto const res = f.template apply<T0>(std::forward<Args>(args)...);
+			if constexpr (sizeof...(Ts) > 0)
+			{
+				if (!res) { return res; }
+				return foreach<Ts...>::template exec(std::forward<F>(f), std::forward<Args>(args)...);
+			}
+			else
+			{
+				return res;
+			}
+		}
 	}
 
 	template <class CTX, class PREV, class F, class... Args>
-	static constexpr void exec_prev(F&& f, Args&&... args)
+	static constexpr auto exec_prev(F&& f, Args&&... args)
 	{
-		f.template apply<CTX, PREV, T0>(std::forward<Args>(args)...);
-		foreach<Ts...>::template exec_prev<CTX, T0>(std::forward<F>(f), std::forward<Args>(args)...);
+		if constexpr (std::is_void_v<decltype(f.template apply<CTX, PREV, T0>(std::forward<Args>(args)...))>)
+		{
+			f.template apply<CTX, PREV, T0>(std::forward<Args>(args)...);
+			return foreach<Ts...>::template exec_prev<CTX, T0>(std::forward<F>(f), std::forward<Args>(args)...);
+		}
+		else
+		{
+			auto const res = f.template apply<CTX, PREV, T0>(std::forward<Args>(args)...);
+			if constexpr (sizeof...(Ts) > 0)
+			{
+				if (!res) { return res; }
+				return foreach<Ts...>::template exec_prev<CTX, T0>(std::forward<F>(f), std::forward<Args>(args)...);
+			}
+			else
+			{
+				return res;
+			}
+		}
 	}
 };
 
@@ -123,6 +123,21 @@ template <class L, class... T> using list_push_front_t = typename list_push<L, T
 template <class L, class... T> using list_push_back_t = typename list_push<L, T...>::back;
 
 
+/* --- reverse order of types in list --- */
+template <class L> struct list_reverse {};
+template <template<class...> class L>
+struct list_reverse<L<>>
+{
+	using type = L<>;
+};
+template <template<class...> class L, class T0, class... T>
+struct list_reverse<L<T0, T...>>
+{
+	using type = list_push_back_t<typename list_reverse<L<T...>>::type, T0>;
+};
+template <class L> using list_reverse_t = typename list_reverse<L>::type;
+
+
 /* --- append lists of types into one --- */
 template <class... Ts> struct append;
 template <class T> struct append<T> { using type = T; };
@@ -150,6 +165,46 @@ template <class L, class P>
 using remove_if_t = typename remove_if<L, P>::type;
 
 
+/* --- leading types of list before the 1st one matching predicate --- */
+template <class L, class P>
+struct list_before {};
+
+template <template<class...> class L, class P>
+struct list_before<L<>, P>
+{
+	using type = L<>;
+};
+
+template <template<class...> class L, class T0, class... T, class P>
+struct list_before<L<T0, T...>, P>
+{
+	using type = conditional_t<P::template value<T0>, L<>, list_push_front_t<typename list_before<L<T...>, P>::type, T0>>;
+};
+
+template <class L, class P>
+using list_before_t = typename list_before<L, P>::type;
+
+
+/* --- trailing types of list from the 1st one matching predicate --- */
+template <class L, class P>
+struct list_from {};
+
+template <template<class...> class L, class P>
+struct list_from<L<>, P>
+{
+	using type = L<>;
+};
+
+template <template<class...> class L, class T0, class... T, class P>
+struct list_from<L<T0, T...>, P>
+{
+	using type = conditional_t<P::template value<T0>, L<T0, T...>, typename list_from<L<T...>, P>::type>;
+};
+
+template <class L, class P>
+using list_from_t = typename list_from<L, P>::type;
+
+
 /* --- interleave two lists of types --- */
 template <class L1, class L2> struct interleave;
 
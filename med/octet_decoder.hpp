@@ -40,36 +40,81 @@ struct octet_decoder : sl::octet_info
 	auto operator() (GET_STATE)                 { return get_context().buffer().get_state(); }
 	template <class IE>
 	bool operator() (CHECK_STATE, IE const&)    { return !get_context().buffer().empty(); }
-	void operator() (ADVANCE_STATE ss)          { get_context().buffer().template advance<ADVANCE_STATE>(ss.delta); }
-	void operator() (ADD_PADDING pad)           { get_context().buffer().template advance<ADD_PADDING>(pad.pad_size); }
+	MED_RESULT operator() (ADVANCE_STATE ss)
+	{
+		get_context().buffer().template advance<ADVANCE_STATE>(ss.delta);
+		MED_RETURN_ON_ERROR(*this);
+		MED_RETURN_SUCCESS;
+	}
+	template <class IE>
+	MED_RESULT operator() (SKIP_STATE ss, IE const&) { return get_context().buffer().template skip<IE>(ss.size); }
+	MED_RESULT operator() (ADD_PADDING pad)
+	{
+		get_context().buffer().template advance<ADD_PADDING>(pad.pad_size);
+		MED_RETURN_ON_ERROR(*this);
+		MED_RETURN_SUCCESS;
+	}
+	template <class IE>
+	MED_RESULT operator() (CHECK_SIZE cs, IE const&) { return get_context().buffer().template require<IE>(cs.size); }
 
 	//IE_TAG
 	template <class IE> [[nodiscard]] auto operator() (IE&, IE_TAG)
 	{
 		as_writable_t<IE> ie;
-		(*this)(ie, typename as_writable_t<IE>::ie_type{});
+		(void)(*this)(ie, typename as_writable_t<IE>::ie_type{});
 		return ie.get_encoded();
 	}
 	//IE_LEN
-	template <class IE> void operator() (IE& ie, IE_LEN)
+	template <class IE> MED_RESULT operator() (IE& ie, IE_LEN)
 	{
-		(*this)(ie, typename IE::ie_type{});
+		return (*this)(ie, typename IE::ie_type{});
 	}
 
 	//IE_NULL
-	template <class IE> void operator() (IE&, IE_NULL)
+	template <class IE> MED_RESULT operator() (IE&, IE_NULL)
 	{
 		CODEC_TRACE("NULL[%s]: %s", name<IE>(), get_context().buffer().toString());
+		MED_RETURN_SUCCESS;
 	}
 
 	//IE_VALUE
-	template <class IE> void operator() (IE& ie, IE_VALUE)
+	template <class IE> MED_RESULT operator() (IE& ie, IE_VALUE)
 	{
-		using value_t = typename IE::value_type;
 		constexpr auto NUM_BITS = IE::traits::bits + IE::traits::offset;
-		constexpr auto NUM_BYTES = bits_to_bytes(NUM_BITS);
 		uint8_t const* pval = get_context().buffer().template advance_bits<IE, NUM_BITS>();
+		MED_RETURN_ON_ERROR(*this);
+		return set_value(ie, pval);
+	}
+	//IE_VALUE in the run of checked size
+	template <class IE> MED_RESULT operator() (IE& ie, IE_VALUE, UNCHECKED)
+	{
+		constexpr auto NUM_BITS = IE::traits::bits + IE::traits::offset;
+		return set_value(ie, get_context().buffer().template advance_unchecked<NUM_BITS>());
+	}
+
+	//IE_OCTET_STRING
+	template <class IE> MED_RESULT operator() (IE& ie, IE_OCTET_STRING)
+	{
+		CODEC_TRACE("STR[%s] <-(%zu bytes): %s", name<IE>(), get_context().buffer().size(), get_context().buffer().toString());
+		if (ie.set_encoded(get_context().buffer().size(), get_context().buffer().begin()))
+		{
+			CODEC_TRACE("STR[%s] -> len = %zu bytes", name<IE>(), std::size_t(ie.size()));
+			get_context().buffer().template advance<IE>(ie.size());
+			MED_RETURN_ON_ERROR(*this);
+			MED_RETURN_SUCCESS;
+		}
+		else
+		{
+			MED_THROW_EXCEPTION(invalid_value, name<IE>(), ie.size(), get_context().buffer())
+		}
+	}
 
+private:
+	template <class IE> MED_RESULT set_value(IE& ie, uint8_t const* pval)
+	{
+		using value_t = typename IE::value_type;
+		constexpr auto NUM_BITS = IE::traits::bits + IE::traits::offset;
+		constexpr auto NUM_BYTES = bits_to_bytes(NUM_BITS);
 		auto const val = [](uint8_t const* in)
 		{
 			if constexpr (IE::traits::offset == 0 && (IE::traits::bits % 8) == 0)
@@ -103,24 +148,9 @@ struct octet_decoder : sl::octet_info
 			ie.set_encoded(val);
 		}
 		CODEC_TRACE("VAL=%zXh [%s]: %s", std::size_t(val), name<IE>(), get_context().buffer().toString());
+		MED_RETURN_SUCCESS;
 	}
 
-	//IE_OCTET_STRING
-	template <class IE> void operator() (IE& ie, IE_OCTET_STRING)
-	{
-		CODEC_TRACE("STR[%s] <-(%zu bytes): %s", name<IE>(), get_context().buffer().size(), get_context().buffer().toString());
-		if (ie.set_encoded(get_context().buffer().size(), get_context().buffer().begin()))
-		{
-			CODEC_TRACE("STR[%s] -> len = %zu bytes", name<IE>(), std::size_t(ie.size()));
-			get_context().buffer().template advance<IE>(ie.size());
-		}
-		else
-		{
-			MED_THROW_EXCEPTION(invalid_value, name<IE>(), ie.size(), get_context().buffer())
-		}
-	}
-
-private:
 	DEC_CTX& m_ctx;
 };
 
@@ -19,7 +19,11 @@ Distributed under the MIT License
 
 namespace med {
 
-template <class ENC_CTX>
+//selects single-pass encoding of lengths which are patched after IE is encoded
+struct patch_length_t {};
+inline constexpr patch_length_t patch_length{};
+
+template <class ENC_CTX, bool PATCH_LENGTH = false>
 struct octet_encoder : sl::octet_info
 {
 	//required for length_encoder
@@ -27,8 +31,11 @@ struct octet_encoder : sl::octet_info
 	template <class... PA>
 	using padder_type = octet_padder<PA...>;
 	using allocator_type = typename ENC_CTX::allocator_type;
+	//lengths are fixed-width so can be reserved and patched instead of calculated in advance
+	static constexpr bool patch_length = PATCH_LENGTH;
 
 	explicit octet_encoder(ENC_CTX& ctx_) : m_ctx{ ctx_ } { }
+	octet_encoder(ENC_CTX& ctx_, patch_length_t) : m_ctx{ ctx_ } { }
 	ENC_CTX& get_context() noexcept                   { return m_ctx; }
 	allocator_type& get_allocator()                   { return get_context().get_allocator(); }
 
@@ -36,7 +43,7 @@ struct octet_encoder : sl::octet_info
 	auto operator() (GET_STATE)                       { return get_context().buffer().get_state(); }
 	void operator() (SET_STATE, state_type const& st) { get_context().buffer().set_state(st); }
 	template <class IE>
-	void operator() (SET_STATE, IE const& ie)
+	MED_RESULT operator() (SET_STATE, IE const& ie)
 	{
 		if (auto const ss = get_context().get_snapshot(ie))
 		{
@@ -44,6 +51,7 @@ struct octet_encoder : sl::octet_info
 			if (ss.validate_length(len))
 			{
 				get_context().buffer().set_state(ss);
+				MED_RETURN_SUCCESS;
 			}
 			else
 			{
@@ -59,9 +67,16 @@ struct octet_encoder : sl::octet_info
 	template <class IE>
 	bool operator() (PUSH_STATE, IE const&)           { return get_context().buffer().push_state(); }
 	void operator() (POP_STATE)                       { get_context().buffer().pop_state(); }
-	void operator() (ADVANCE_STATE ss)                { get_context().buffer().template advance<ADVANCE_STATE>(ss.delta); }
-	void operator() (ADD_PADDING pad)                 { get_context().buffer().template fill<ADD_PADDING>(pad.pad_size, pad.filler); }
-	void operator() (SNAPSHOT ss)                     { get_context().put_snapshot(ss); }
+	MED_RESULT operator() (ADVANCE_STATE ss)
+	{
+		get_context().buffer().template advance<ADVANCE_STATE>(ss.delta);
+		MED_RETURN_ON_ERROR(*this);
+		MED_RETURN_SUCCESS;
+	}
+	MED_RESULT operator() (ADD_PADDING pad)           { return get_context().buffer().template fill<ADD_PADDING>(pad.pad_size, pad.filler); }
+	MED_RESULT operator() (SNAPSHOT ss)               { return get_context().put_snapshot(ss); }
+	template <class IE>
+	MED_RESULT operator() (CHECK_SIZE cs, IE const&)  { return get_context().buffer().template require<IE>(cs.size); }
 
 	template <class IE> constexpr std::size_t operator() (GET_LENGTH, IE const& ie) const noexcept
 	{
@@ -86,21 +101,54 @@ struct octet_encoder : sl::octet_info
 	}
 
 	//IE_TAG/IE_LEN
-	template <class IE> void operator() (IE const& ie, IE_TAG)
-		{ (*this)(ie, typename IE::ie_type{}); }
-	template <class IE> void operator() (IE const& ie, IE_LEN)
-		{ (*this)(ie, typename IE::ie_type{}); }
+	template <class IE> MED_RESULT operator() (IE const& ie, IE_TAG)
+		{ return (*this)(ie, typename IE::ie_type{}); }
+	template <class IE> MED_RESULT operator() (IE const& ie, IE_LEN)
+		{ return (*this)(ie, typename IE::ie_type{}); }
 
 	//IE_NULL
-	template <class IE> void operator() (IE const&, IE_NULL)
-		{ CODEC_TRACE("NULL[%s]: %s", name<IE>(), get_context().buffer().toString()); }
+	template <class IE> MED_RESULT operator() (IE const&, IE_NULL)
+		{ CODEC_TRACE("NULL[%s]: %s", name<IE>(), get_context().buffer().toString()); MED_RETURN_SUCCESS; }
 
 	//IE_VALUE
-	template <class IE> void operator() (IE const& ie, IE_VALUE)
+	template <class IE> MED_RESULT operator() (IE const& ie, IE_VALUE)
 	{
 		constexpr auto NUM_BITS = IE::traits::bits + IE::traits::offset;
-		constexpr auto NUM_BYTES = bits_to_bytes(NUM_BITS);
 		uint8_t* out = get_context().buffer().template advance_bits<IE, NUM_BITS>();
+		MED_RETURN_ON_ERROR(*this);
+		return put_value(ie, out);
+	}
+	//IE_VALUE in the run of checked size
+	template <class IE> MED_RESULT operator() (IE const& ie, IE_VALUE, UNCHECKED)
+	{
+		constexpr auto NUM_BITS = IE::traits::bits + IE::traits::offset;
+		return put_value(ie, get_context().buffer().template advance_unchecked<NUM_BITS>());
+	}
+
+	//IE_OCTET_STRING
+	template <class IE> MED_RESULT operator() (IE const& ie, IE_OCTET_STRING)
+	{
+		//refer external data in place if buffer gathers (see iovec_buffer)
+		if constexpr (AExternOctets<IE> && requires { get_context().buffer().gather(ie.data(), ie.size()); })
+		{
+			if (get_context().buffer().gather(ie.data(), ie.size()))
+			{
+				CODEC_TRACE("STR[%s] %zu octets referred: %s", name<IE>(), ie.size(), get_context().buffer().toString());
+				MED_RETURN_SUCCESS;
+			}
+		}
+		uint8_t* out = get_context().buffer().template advance<IE>(ie.size());
+		MED_RETURN_ON_ERROR(*this);
+		octets<IE::traits::min_octets, IE::traits::max_octets>::copy(out, ie.data(), ie.size());
+		CODEC_TRACE("STR[%s] %zu octets: %s", name<IE>(), ie.size(), get_context().buffer().toString());
+		MED_RETURN_SUCCESS;
+	}
+
+private:
+	template <class IE> MED_RESULT put_value(IE const& ie, uint8_t* out)
+	{
+		constexpr auto NUM_BITS = IE::traits::bits + IE::traits::offset;
+		constexpr auto NUM_BYTES = bits_to_bytes(NUM_BITS);
 		if constexpr (IE::traits::offset == 0 && (IE::traits::bits % 8) == 0)
 		{
 			put_bytes<NUM_BYTES>(ie.get_encoded(), out);
@@ -116,18 +164,15 @@ struct octet_encoder : sl::octet_info
 			put_bytes<NUM_BYTES>(val, out);
 		}
 		CODEC_TRACE("V=%zXh %zu@%zu bits[%s]: %s", std::size_t(ie.get_encoded()), IE::traits::bits, IE::traits::offset, name<IE>(), get_context().buffer().toString());
+		MED_RETURN_SUCCESS;
 	}
 
-	//IE_OCTET_STRING
-	template <class IE> void operator() (IE const& ie, IE_OCTET_STRING)
-	{
-		uint8_t* out = get_context().buffer().template advance<IE>(ie.size());
-		octets<IE::traits::min_octets, IE::traits::max_octets>::copy(out, ie.data(), ie.size());
-		CODEC_TRACE("STR[%s] %zu octets: %s", name<IE>(), ie.size(), get_context().buffer().toString());
-	}
-
-private:
 	ENC_CTX& m_ctx;
 };
 
+template <class ENC_CTX>
+octet_encoder(ENC_CTX&) -> octet_encoder<ENC_CTX>;
+template <class ENC_CTX>
+octet_encoder(ENC_CTX&, patch_length_t) -> octet_encoder<ENC_CTX, true>;
+
 }	//end: namespace med
@@ -54,10 +54,11 @@ private:
 };
 
 //variable length octets with external storage
+//NOTE: data out of link range is not assigned (see MED_EXTERN_LINK_OFFSET)
 class octets_var_extern
 {
 public:
-	bool is_set() const                         { return m_data != nullptr; }
+	bool is_set() const                         { return m_data.get() != nullptr; }
 
 	std::size_t size() const                    { return m_size; }
 	uint8_t const* data() const                 { return m_data; }
@@ -65,13 +66,22 @@ public:
 	void clear()                                { m_data = nullptr; m_size = 0; }
 	void assign(void const* b_, void const* e_)
 	{
-		m_data = static_cast<uint8_t const*>(b_);
-		m_size = num_octs_t(static_cast<uint8_t const*>(e_) - m_data);
+		auto const* b = static_cast<uint8_t const*>(b_);
+		if (m_data.reaches(b))
+		{
+			m_data = b;
+			m_size = num_octs_t(static_cast<uint8_t const*>(e_) - b);
+		}
+		else
+		{
+			clear();
+		}
 	}
 
 private:
-	uint8_t const* m_data {nullptr};
-	num_octs_t     m_size {0}; //not using size_t to reduce layout size
+	//NOTE: size goes 1st for empty string referring its IE to be linked (see octet_string_impl::set)
+	num_octs_t m_size {0}; //not using size_t to reduce layout size
+	link<uint8_t const, MED_EXTERN_LINK_OFFSET> m_data;
 };
 
 //variable length octets with internal storage
@@ -105,6 +115,7 @@ private:
 };
 
 //fixed length octets with external storage
+//NOTE: data out of link range is not assigned (see MED_EXTERN_LINK_OFFSET)
 template <std::size_t LEN>
 class octets_fix_extern
 {
@@ -115,10 +126,10 @@ public:
 	uint8_t const* data() const                 { return m_data; }
 
 	void clear()                                { m_data = nullptr; }
-	void assign(uint8_t const* p, void const*)  { m_data = p; }
+	void assign(uint8_t const* p, void const*)  { m_data = m_data.reaches(p) ? p : nullptr; }
 
 private:
-	uint8_t const* m_data {nullptr};
+	link<uint8_t const, MED_EXTERN_LINK_OFFSET> m_data;
 };
 
 //fixed length octets with internal storage
@@ -144,6 +155,14 @@ private:
 	bool        m_is_set {false};
 };
 
+//storage referring to the data outside of IE
+template <class T> constexpr bool is_extern_octets_v = false;
+template <> inline constexpr bool is_extern_octets_v<octets_var_extern> = true;
+template <std::size_t LEN> constexpr bool is_extern_octets_v<octets_fix_extern<LEN>> = true;
+
+template <class IE>
+concept AExternOctets = is_extern_octets_v<typename IE::value_type>;
+
 
 template <class TRAITS, class VALUE = octets_var_extern>
 struct octet_string_impl : IE<IE_OCTET_STRING>
@@ -190,15 +209,14 @@ struct octet_string_impl : IE<IE_OCTET_STRING>
 	template <typename T, std::size_t N>
 	bool set(T const(&arr)[N])                  { return set(N * sizeof(T), arr); }
 
-	//NOTE: do not override!
-	bool set_encoded(std::size_t len, void const* data)
+	//checks the length against the limits
+	static constexpr bool fits(std::size_t len)
 	{
 		if constexpr (traits::min_octets != 0)
 		{
 			if (len < traits::min_octets)
 			{
 				CODEC_TRACE("ERROR: len=%zu < min=%zu", len, traits::min_octets);
-				//m_value.clear();
 				return false;
 			}
 		}
@@ -207,10 +225,16 @@ struct octet_string_impl : IE<IE_OCTET_STRING>
 			if (len > traits::max_octets)
 			{
 				CODEC_TRACE("ERROR: len=%zu > max=%zu", len, traits::max_octets);
-				//m_value.clear();
 				return false;
 			}
 		}
+		return true;
+	}
+
+	//NOTE: do not override!
+	bool set_encoded(std::size_t len, void const* data)
+	{
+		if (not fits(len)) { return false; }
 		auto it = static_cast<iterator>(data);
 		m_value.assign(it, it + len);
 		return is_set();
@@ -54,14 +54,14 @@ struct optional<
 	static_assert(MAX > 1, "MAX SHOULD BE MORE THAN 1 OR NOT SPECIFIED");
 };
 
-template <AField FIELD, std::size_t MAX>
+template <AField FIELD, std::size_t MAX, class STORAGE>
 struct optional<
 	FIELD,
-	pmax<MAX>,
+	pmax<MAX, STORAGE>,
 	void,
 	min<1>,
 	max<1>
-> : multi_field<FIELD, 1, pmax<MAX>>, optional_t
+> : multi_field<FIELD, 1, pmax<MAX, STORAGE>>, optional_t
 {
 	static_assert(MAX > 1, "MAX SHOULD BE MORE THAN 1 OR NOT SPECIFIED");
 };
@@ -109,14 +109,14 @@ struct optional<
 	static_assert(MAX > 1, "MAX SHOULD BE MORE THAN 1 OR NOT SPECIFIED");
 };
 
-template <AField FIELD, std::size_t MAX, ACondition CONDITION>
+template <AField FIELD, std::size_t MAX, ACondition CONDITION, class STORAGE>
 struct optional<
 	FIELD,
-	pmax<MAX>,
+	pmax<MAX, STORAGE>,
 	CONDITION,
 	min<1>,
 	max<1>
-> : multi_field<FIELD, 1, pmax<MAX>>, optional_t
+> : multi_field<FIELD, 1, pmax<MAX, STORAGE>>, optional_t
 {
 	using condition = CONDITION;
 	static_assert(MAX > 1, "MAX SHOULD BE MORE THAN 1 OR NOT SPECIFIED");
@@ -136,14 +136,14 @@ struct optional<
 	static_assert(MAX > 1, "MAX SHOULD BE MORE THAN 1 OR NOT SPECIFIED");
 };
 
-template <AField FIELD, ACondition CONDITION, std::size_t MAX>
+template <AField FIELD, ACondition CONDITION, std::size_t MAX, class STORAGE>
 struct optional<
 	FIELD,
 	CONDITION,
-	pmax<MAX>,
+	pmax<MAX, STORAGE>,
 	min<1>,
 	max<1>
-> : multi_field<FIELD, 1, pmax<MAX>>, optional_t
+> : multi_field<FIELD, 1, pmax<MAX, STORAGE>>, optional_t
 {
 	using condition = CONDITION;
 	static_assert(MAX > 1, "MAX SHOULD BE MORE THAN 1 OR NOT SPECIFIED");
@@ -165,14 +165,14 @@ struct optional<
 	static_assert(MAX > 1, "MAX SHOULD BE MORE THAN 1 OR NOT SPECIFIED");
 };
 
-template <ACounter COUNTER, AField FIELD, std::size_t MAX>
+template <ACounter COUNTER, AField FIELD, std::size_t MAX, class STORAGE>
 struct optional<
 	COUNTER,
 	FIELD,
-	pmax<MAX>,
+	pmax<MAX, STORAGE>,
 	min<1>,
 	max<1>
-> : multi_field<FIELD, 1, pmax<MAX>>, COUNTER, optional_t
+> : multi_field<FIELD, 1, pmax<MAX, STORAGE>>, COUNTER, optional_t
 {
 	static_assert(MAX > 1, "MAX SHOULD BE MORE THAN 1 OR NOT SPECIFIED");
 };
@@ -191,14 +191,14 @@ struct optional<
 	static_assert(MAX > 1, "MAX SHOULD BE MORE THAN 1 OR NOT SPECIFIED");
 };
 
-template <AField FIELD, std::size_t MAX, ACountGetter COUNTER>
+template <AField FIELD, std::size_t MAX, ACountGetter COUNTER, class STORAGE>
 struct optional<
 	FIELD,
-	pmax<MAX>,
+	pmax<MAX, STORAGE>,
 	COUNTER,
 	min<1>,
 	max<1>
-> : multi_field<FIELD, 1, pmax<MAX>>, optional_t
+> : multi_field<FIELD, 1, pmax<MAX, STORAGE>>, optional_t
 {
 	using count_getter = COUNTER;
 	static_assert(MAX > 1, "MAX SHOULD BE MORE THAN 1 OR NOT SPECIFIED");
@@ -219,14 +219,14 @@ struct optional<
 	static_assert(MAX > MIN, "MAX SHOULD BE MORE THAN MIN OR NOT SPECIFIED");
 };
 
-template <AField FIELD, std::size_t MIN, std::size_t MAX, ACountGetter COUNTER>
+template <AField FIELD, std::size_t MIN, std::size_t MAX, ACountGetter COUNTER, class STORAGE>
 struct optional<
 	FIELD,
 	min<MIN>,
-	pmax<MAX>,
+	pmax<MAX, STORAGE>,
 	COUNTER,
 	max<1>
-> : multi_field<FIELD, MIN, pmax<MAX>>, optional_t
+> : multi_field<FIELD, MIN, pmax<MAX, STORAGE>>, optional_t
 {
 	using count_getter = COUNTER;
 	static_assert(MIN > 1, "MIN SHOULD BE MORE THAN 1 OR NOT SPECIFIED");
@@ -247,14 +247,14 @@ struct optional<
 	static_assert(MAX > MIN, "MAX SHOULD BE MORE THAN MIN OR NOT SPECIFIED");
 };
 
-template <ACounter COUNTER, AField FIELD, std::size_t MIN, std::size_t MAX>
+template <ACounter COUNTER, AField FIELD, std::size_t MIN, std::size_t MAX, class STORAGE>
 struct optional<
 	COUNTER,
 	FIELD,
 	min<MIN>,
-	pmax<MAX>,
+	pmax<MAX, STORAGE>,
 	max<1>
-> : multi_field<FIELD, MIN, pmax<MAX>>, COUNTER, optional_t
+> : multi_field<FIELD, MIN, pmax<MAX, STORAGE>>, COUNTER, optional_t
 {
 	static_assert(MIN > 1, "MIN SHOULD BE MORE THAN 1 OR NOT SPECIFIED");
 	static_assert(MAX > MIN, "MAX SHOULD BE MORE THAN MIN OR NOT SPECIFIED");
@@ -300,14 +300,14 @@ struct optional<
 	static_assert(MAX > 1, "MAX SHOULD BE MORE THAN 1 OR NOT SPECIFIED");
 };
 
-template <ATag TAG, AField FIELD, std::size_t MAX>
+template <ATag TAG, AField FIELD, std::size_t MAX, class STORAGE>
 struct optional<
 	TAG,
 	FIELD,
-	pmax<MAX>,
+	pmax<MAX, STORAGE>,
 	min<1>,
 	max<1>
-> : multi_field<FIELD, 1, pmax<MAX>, void, add_tag<TAG>>, optional_t
+> : multi_field<FIELD, 1, pmax<MAX, STORAGE>, void, add_tag<TAG>>, optional_t
 {
 	static_assert(MAX > 1, "MAX SHOULD BE MORE THAN 1 OR NOT SPECIFIED");
 };
@@ -339,14 +339,14 @@ struct optional<
 	static_assert(MAX > MIN, "MAX SHOULD BE MORE THAN MIN OR NOT SPECIFIED");
 };
 
-template <AField FIELD, std::size_t MIN, std::size_t MAX>
+template <AField FIELD, std::size_t MIN, std::size_t MAX, class STORAGE>
 struct optional<
 	FIELD,
 	min<MIN>,
-	pmax<MAX>,
+	pmax<MAX, STORAGE>,
 	min<1>,
 	max<1>
-> : multi_field<FIELD, MIN, pmax<MAX>>, optional_t
+> : multi_field<FIELD, MIN, pmax<MAX, STORAGE>>, optional_t
 {
 	static_assert(MIN > 1, "MIN SHOULD BE MORE THAN 1 OR NOT SPECIFIED");
 	static_assert(MAX > MIN, "MAX SHOULD BE MORE THAN MIN OR NOT SPECIFIED");
@@ -403,14 +403,14 @@ struct optional<
 	static_assert(MAX > 1, "MAX SHOULD BE MORE THAN 1 OR NOT SPECIFIED");
 };
 
-template <ATag TAG, ALength LEN, AField FIELD, std::size_t MAX>
+template <ATag TAG, ALength LEN, AField FIELD, std::size_t MAX, class STORAGE>
 struct optional<
 	TAG,
 	LEN,
 	FIELD,
-	pmax<MAX>,
+	pmax<MAX, STORAGE>,
 	max<1>
-> : multi_field<FIELD, 1, pmax<MAX>, void, add_tag<TAG>, add_len<typename LEN::length_type>>, optional_t
+> : multi_field<FIELD, 1, pmax<MAX, STORAGE>, void, add_tag<TAG>, add_len<typename LEN::length_type>>, optional_t
 {
 	static_assert(MAX > 1, "MAX SHOULD BE MORE THAN 1 OR NOT SPECIFIED");
 };
@@ -428,14 +428,14 @@ struct optional<
 	static_assert(MAX > MIN, "MAX SHOULD BE MORE THAN MIN OR NOT SPECIFIED");
 };
 
-template <ATag TAG, ALength LEN, AField FIELD, std::size_t MIN, std::size_t MAX>
+template <ATag TAG, ALength LEN, AField FIELD, std::size_t MIN, std::size_t MAX, class STORAGE>
 struct optional<
 	TAG,
 	LEN,
 	FIELD,
 	min<MIN>,
-	pmax<MAX>
-> : multi_field<FIELD, MIN, pmax<MAX>, void, add_tag<TAG>, add_len<typename LEN::length_type>>, optional_t
+	pmax<MAX, STORAGE>
+> : multi_field<FIELD, MIN, pmax<MAX, STORAGE>, void, add_tag<TAG>, add_len<typename LEN::length_type>>, optional_t
 {
 	static_assert(MIN > 1, "MIN SHOULD BE MORE THAN 1 OR NOT SPECIFIED");
 	static_assert(MAX > MIN, "MAX SHOULD BE MORE THAN MIN OR NOT SPECIFIED");
@@ -480,14 +480,14 @@ struct optional<
 	static_assert(MAX > 1, "MAX SHOULD BE MORE THAN 1 OR NOT SPECIFIED");
 };
 
-template <ALength LEN, AField FIELD, std::size_t MAX>
+template <ALength LEN, AField FIELD, std::size_t MAX, class STORAGE>
 struct optional<
 	LEN,
 	FIELD,
-	pmax<MAX>,
+	pmax<MAX, STORAGE>,
 	min<1>,
 	max<1>
-> : multi_field<FIELD, 1, pmax<MAX>, void, add_len<typename LEN::length_type>>, optional_t
+> : multi_field<FIELD, 1, pmax<MAX, STORAGE>, void, add_len<typename LEN::length_type>>, optional_t
 {
 	static_assert(MAX > 1, "MAX SHOULD BE MORE THAN 1 OR NOT SPECIFIED");
 };
@@ -505,14 +505,14 @@ struct optional<
 	static_assert(MAX > MIN, "MAX SHOULD BE MORE THAN MIN OR NOT SPECIFIED");
 };
 
-template <ALength LEN, AField FIELD, std::size_t MIN, std::size_t MAX>
+template <ALength LEN, AField FIELD, std::size_t MIN, std::size_t MAX, class STORAGE>
 struct optional<
 	LEN,
 	FIELD,
 	min<MIN>,
-	pmax<MAX>,
+	pmax<MAX, STORAGE>,
 	max<1>
-> : multi_field<FIELD, MIN, pmax<MAX>, void, add_len<typename LEN::length_type>>, optional_t
+> : multi_field<FIELD, MIN, pmax<MAX, STORAGE>, void, add_len<typename LEN::length_type>>, optional_t
 {
 	static_assert(MIN > 1, "MIN SHOULD BE MORE THAN 1 OR NOT SPECIFIED");
 	static_assert(MAX > MIN, "MAX SHOULD BE MORE THAN MIN OR NOT SPECIFIED");
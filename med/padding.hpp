@@ -14,6 +14,7 @@ Distributed under the MIT License
 #include "config.hpp"
 #include "units.hpp"
 #include "debug.hpp"
+#include "exception.hpp"
 #include "state.hpp"
 
 namespace med {
@@ -122,13 +123,14 @@ struct octet_padder
 		return padding_size;
 	}
 
-	void add_padding() const
+	MED_RESULT add_padding() const
 	{
 		if (auto const pad_bytes = padding_size())
 		{
 			CODEC_TRACE("PADDING %u bytes", pad_bytes);
-			m_func(ADD_PADDING{pad_bytes, PAD_TRAITS::filler});
+			return m_func(ADD_PADDING{pad_bytes, PAD_TRAITS::filler});
 		}
+		MED_RETURN_SUCCESS;
 	}
 
 	//current padding size in units of codec
@@ -0,0 +1,257 @@
+/**
+@file
+presence of IEs kept by their container: bitmap of packed values and generation
+
+@copyright Denis Priyomov 2016-2017
+Distributed under the MIT License
+(See accompanying file LICENSE or visit https://github.com/cppden/med)
+*/
+
+#pragma once
+
+#include <cstdint>
+#include <utility>
+
+#include "ie_type.hpp"
+#include "value_traits.hpp"
+#include "concepts.hpp"
+#include "accessor.hpp"
+#include "meta/typelist.hpp"
+
+namespace med {
+
+//value w/o presence flag (see packed)
+template <class IE>
+concept APackedField = requires { typename IE::traits; typename IE::ie_type; }
+	&& std::is_same_v<IE_VALUE, typename IE::ie_type>
+	&& std::is_base_of_v<packed, typename IE::traits>;
+
+//single-instance packed value w/ presence kept by container
+template <class IE>
+concept APackedValue = APackedField<IE> && !AMultiField<IE>;
+
+namespace detail {
+
+//bitmap of presence for NUM packed values of container
+template <std::size_t NUM>
+struct presence_bits
+{
+	using word_t = conditional_t<(NUM <= 8), uint8_t,
+		conditional_t<(NUM <= 16), uint16_t,
+		conditional_t<(NUM <= 32), uint32_t, uint64_t>>>;
+	static constexpr std::size_t word_bits = sizeof(word_t) * 8;
+	static constexpr word_t mask(std::size_t bit)   { return word_t(1) << (bit % word_bits); }
+
+	bool test(std::size_t bit) const noexcept       { return m_words[bit / word_bits] & mask(bit); }
+	void set(std::size_t bit) noexcept              { m_words[bit / word_bits] |= mask(bit); }
+	void reset(std::size_t bit) noexcept            { m_words[bit / word_bits] &= word_t(~mask(bit)); }
+	void reset() noexcept                           { for (auto& w : m_words) { w = 0; } }
+	bool any() const noexcept
+	{
+		for (auto const w : m_words) { if (w) { return true; } }
+		return false;
+	}
+
+	word_t m_words[(NUM + word_bits - 1) / word_bits]{};
+};
+
+template <>
+struct presence_bits<0>
+{
+	static constexpr void reset() noexcept          { }
+	static constexpr bool any() noexcept            { return false; }
+};
+
+/**
+ * Packed value inside container with its presence in the bitmap of container
+ * @tparam IES storage of container derived from this one holding m_presence
+ * @tparam BIT index of bit in the bitmap
+ * @tparam IE the value IE (e.g. O<T, FIELD>)
+ */
+template <class IES, std::size_t BIT, class IE>
+struct packed_ie : IE
+{
+	using value_type = typename IE::value_type;
+
+	bool is_set() const noexcept                    { return presence().test(BIT); }
+	explicit operator bool() const noexcept         { return is_set(); }
+	void clear() noexcept                           { presence().reset(BIT); }
+	void set_encoded(value_type v) noexcept         { IE::set_encoded(v); presence().set(BIT); }
+	auto set(value_type v) noexcept                 { return set_encoded(v); }
+	template <class FROM, class... ARGS>
+	void copy(FROM const& from, ARGS&&...) noexcept
+	{
+		if (from.is_set()) { set_encoded(from.get_encoded()); }
+		else { clear(); }
+	}
+
+	bool operator==(packed_ie const& rhs) const noexcept
+	{
+		return is_set() == rhs.is_set() && (!is_set() || this->get_encoded() == rhs.get_encoded());
+	}
+
+private:
+	auto& presence() noexcept                       { return static_cast<IES&>(*this).m_presence; }
+	auto const& presence() const noexcept           { return static_cast<IES const&>(*this).m_presence; }
+};
+
+//IEs of container with packed values replaced by packed_ie
+template <class IES, class L, class INDEX = std::make_index_sequence<meta::list_size_v<L>>>
+struct presence_layout;
+
+template <class IES, class... IE, std::size_t... I>
+struct presence_layout<IES, meta::typelist<IE...>, std::index_sequence<I...>>
+{
+	//NOTE: setter is applied to a copy of IE on encode which has no container
+	static_assert((true && ... && !(APackedValue<IE> && AHasSetterType<IE>)), "PACKED VALUE CAN'T HAVE SETTER");
+
+	static constexpr bool packed[] = {APackedValue<IE>..., false};
+	static constexpr std::size_t bit(std::size_t index)
+	{
+		std::size_t num = 0;
+		for (std::size_t i = 0; i < index; ++i) { num += packed[i]; }
+		return num;
+	}
+
+	static constexpr std::size_t num_bits = bit(sizeof...(IE));
+	using type = meta::typelist<conditional_t<APackedValue<IE>, packed_ie<IES, bit(I), IE>, IE>...>;
+};
+
+//IEs to derive storage of container from
+template <class L> struct inherit_list;
+template <class... IE> struct inherit_list<meta::typelist<IE...>> : IE... {};
+
+} //end: namespace detail
+
+/**
+ * Opt-in of sequence or set given as its 1st IE to clear it by increment of
+ * generation instead of clearing each IE (e.g. message reused for each decode):
+ * IE is cleared lazily on its 1st access once its stamp is behind generation.
+ * @tparam T unsigned counter of generations: all IEs are cleared once it wraps
+ */
+template <class T = uint8_t>
+struct generation
+{
+	static_assert(std::is_unsigned_v<T>, "UNSIGNED COUNTER IS EXPECTED");
+	using counter_type = T;
+};
+
+namespace detail {
+
+//generation counter (if any) and IEs of container
+template <class... IES>
+struct split_generation
+{
+	using counter_type = void;
+	using ies_types = meta::typelist<IES...>;
+};
+
+template <class T, class... IES>
+struct split_generation<generation<T>, IES...>
+{
+	using counter_type = T;
+	using ies_types = meta::typelist<IES...>;
+};
+
+//IE of generation_ies reached by conversion
+template <class IES, class IE>
+struct ie_access
+{
+	operator IE&()                                  { return static_cast<IES&>(*this).template access<IE>(); }
+	operator IE const&() const                      { return static_cast<IES const&>(*this).template access<IE>(); }
+};
+
+/**
+ * Storage of container with generation: IEs aren't its bases but converted to
+ * so IE behind generation is cleared on 1st access or looks cleared via const
+ * access w/o change of the message (packed values are cleared w/ the bitmap).
+ * @tparam FIELDS IEs with the bitmap of packed values
+ * @tparam T counter of generations
+ * @tparam L list of IEs in FIELDS
+ */
+template <class FIELDS, class T, class L> struct generation_ies;
+
+template <class FIELDS, class T, class... IE>
+struct generation_ies<FIELDS, T, meta::typelist<IE...>>
+	: ie_access<generation_ies<FIELDS, T, meta::typelist<IE...>>, IE>...
+{
+	using ies_types = meta::typelist<IE...>;
+
+	FIELDS& fields() noexcept                       { return m_fields; }
+	FIELDS const& fields() const noexcept           { return m_fields; }
+
+	template <class X>
+	X& access()
+	{
+		auto& stamp = m_stamp[meta::list_index_of_v<X, ies_types>];
+		if (stamp != m_gen)
+		{
+			stamp = m_gen;
+			static_cast<X&>(m_fields).clear();
+		}
+		return m_fields;
+	}
+
+	template <class X>
+	X const& access() const
+	{
+		if constexpr (APackedValue<X>)
+		{
+			return m_fields;
+		}
+		else
+		{
+			static X const cleared{};
+			return m_stamp[meta::list_index_of_v<X, ies_types>] == m_gen ? static_cast<X const&>(m_fields) : cleared;
+		}
+	}
+
+	template <class FIELD>
+	decltype(auto) as() const
+	{
+		using X = meta::find_t<ies_types, sl::field_at<FIELD>>;
+		static_assert(!std::is_void<X>(), "NO SUCH FIELD");
+		return access<X>();
+	}
+
+	template <class FIELD>
+	decltype(auto) as()
+	{
+		using X = meta::find_t<ies_types, sl::field_at<FIELD>>;
+		static_assert(!std::is_void<X>(), "NO SUCH FIELD");
+		return access<X>();
+	}
+
+	//all IEs are cleared at once
+	void next_generation()
+	{
+		m_fields.m_presence.reset();
+		if (++m_gen == 0) //stamps from the last wrap look current again
+		{
+			(static_cast<IE&>(m_fields).clear(), ...);
+			sync();
+		}
+	}
+
+	//all IEs are current (e.g. cleared one by one)
+	void sync() noexcept                            { for (auto& s : m_stamp) { s = m_gen; } }
+
+private:
+	FIELDS m_fields;
+	T      m_gen{0};
+	T      m_stamp[sizeof...(IE)]{};
+};
+
+} //end: namespace detail
+
+namespace sl {
+
+struct is_packed_ie
+{
+	template <class IE>
+	static constexpr bool value = APackedValue<IE>;
+};
+
+} //end: namespace sl
+
+} //end: namespace med
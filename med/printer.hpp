@@ -70,7 +70,7 @@ public:
 	{
 	public:
 		template <class IE>
-		void operator()(printer& me, IE const& ie)
+		MED_RESULT operator()(printer& me, IE const& ie)
 		{
 			if constexpr (AHasName<IE>)
 			{
@@ -86,27 +86,30 @@ public:
 	private:
 		//customized prints
 		template <class IE>
-		void print_named(printer& me, IE const& ie, int_t<2> pt)
+		MED_RESULT print_named(printer& me, IE const& ie, int_t<2> pt)
 		{
 			me.print_named(ie, pt);
+			MED_RETURN_SUCCESS;
 		}
 
 		template <class IE>
-		void print_named(printer& me, IE const& ie, int_t<1> pt)
+		MED_RESULT print_named(printer& me, IE const& ie, int_t<1> pt)
 		{
 			me.print_named(ie, pt);
+			MED_RETURN_SUCCESS;
 		}
 
 		//no customized print, change depth level
 		template <class IE>
-		void print_named(printer& me, IE const& ie, int_t<0>)
+		MED_RESULT print_named(printer& me, IE const& ie, int_t<0>)
 		{
 			me.m_sink.on_container(me.m_depth, name<IE>());
 			auto const depth = me.m_depth++;
 			CODEC_TRACE("depth -> %zu < max=%zu", me.m_depth, me.m_max_depth);
-			if (0 == me.m_max_depth || me.m_max_depth > me.m_depth) { ie.encode(me); }
+			if (0 == me.m_max_depth || me.m_max_depth > me.m_depth) { MED_CHECK_FAIL(ie.encode(me)); }
 			me.m_depth = depth;
 			CODEC_TRACE("depth <- %zu", depth);
+			MED_RETURN_SUCCESS;
 		}
 	};
 
@@ -119,19 +122,23 @@ public:
 
 	//primitive
 	template <class IE, class IE_TYPE>
-	constexpr void operator() (IE const& ie, IE_TYPE const&)
+	constexpr MED_RESULT operator() (IE const& ie, IE_TYPE const&)
 	{
 		if constexpr (AHasName<IE>)
 		{
 			print_named(ie, typename has_print<IE>::type{});
 		}
+		MED_RETURN_SUCCESS;
 	}
 
 	//state
-	constexpr void operator() (SNAPSHOT) { }
+	constexpr MED_RESULT operator() (SNAPSHOT) { MED_RETURN_SUCCESS; }
 	// length encoder
 	template <class IE> constexpr std::size_t operator()(GET_LENGTH, IE const &) { return 0; }
 
+	//error occurred when exceptions are disabled
+	constexpr error_context& error_ctx() noexcept     { return m_error; }
+
 private:
 	friend class container_encoder;
 
@@ -161,6 +168,7 @@ private:
 	SINK        m_sink;
 	std::size_t m_depth {0};
 	std::size_t const m_max_depth;
+	error_context m_error;
 };
 
 //print named IEs only up to given depth (not including, i.e. < max_depth)
@@ -168,6 +176,14 @@ private:
 template <class SINK, class IE, std::size_t MAX_LINE = 128>
 void print(SINK&& sink, IE const& ie, std::size_t max_depth = 0)
 {
+#ifdef MED_NO_EXCEPTION
+	printer<SINK, MAX_LINE> p{std::forward<SINK>(sink), max_depth};
+	if (not encode(p, ie))
+	{
+		char sz[MAX_LINE];
+		sink.on_error(p.error_ctx().format(sz));
+	}
+#else
 	try
 	{
 		encode(printer<SINK, MAX_LINE>{std::forward<SINK>(sink), max_depth}, ie);
@@ -176,6 +192,7 @@ void print(SINK&& sink, IE const& ie, std::size_t max_depth = 0)
 	{
 		sink.on_error(ex.what());
 	}
+#endif
 }
 
 
@@ -188,12 +205,13 @@ struct dumper : public sl::octet_info
 	struct container_encoder
 	{
 		template <class IE>
-		void operator()(dumper& me, IE const& ie)
+		MED_RESULT operator()(dumper& me, IE const& ie)
 		{
 			me.m_sink.on_container(me.m_depth, name<IE>());
 			auto const depth = me.m_depth++;
-			ie.encode(me);
+			MED_CHECK_FAIL(ie.encode(me));
 			me.m_depth = depth;
+			MED_RETURN_SUCCESS;
 		}
 	};
 
@@ -201,18 +219,22 @@ struct dumper : public sl::octet_info
 
 	//primitives
 	template <class IE>
-	void operator() (IE const& ie, PRIMITIVE)   { m_sink.on_value(m_depth, name<IE>(), ie.get()); }
+	MED_RESULT operator() (IE const& ie, PRIMITIVE) { m_sink.on_value(m_depth, name<IE>(), ie.get()); MED_RETURN_SUCCESS; }
 
 	//state
-	constexpr void operator() (SNAPSHOT) const noexcept { }
+	constexpr MED_RESULT operator() (SNAPSHOT) const noexcept { MED_RETURN_SUCCESS; }
 	//length encoder
 	template <class IE> constexpr std::size_t operator()(GET_LENGTH, IE const &) { return 0; }
 
-	template <class IE> constexpr void operator() (IE const&, IE_TAG) const noexcept {}
-	template <class IE> constexpr void operator() (IE const&, IE_LEN) const noexcept {}
+	template <class IE> constexpr MED_RESULT operator() (IE const&, IE_TAG) const noexcept { MED_RETURN_SUCCESS; }
+	template <class IE> constexpr MED_RESULT operator() (IE const&, IE_LEN) const noexcept { MED_RETURN_SUCCESS; }
 
-	SINK        m_sink;
-	std::size_t m_depth {0};
+	//error occurred when exceptions are disabled
+	constexpr error_context& error_ctx() noexcept     { return m_error; }
+
+	SINK          m_sink;
+	std::size_t   m_depth {0};
+	error_context m_error;
 };
 
 //print all (named and not) IEs in full depth
@@ -220,6 +242,13 @@ template <class SINK, class IE, std::size_t MAX_LINE = 128>
 void print_all(SINK&& sink, IE const& ie)
 {
 	dumper<SINK, MAX_LINE> d{std::forward<SINK>(sink)};
+#ifdef MED_NO_EXCEPTION
+	if (not encode(d, ie))
+	{
+		char sz[MAX_LINE];
+		d.m_sink.on_error(d.error_ctx().format(sz));
+	}
+#else
 	try
 	{
 		encode(d, ie);
@@ -228,6 +257,7 @@ void print_all(SINK&& sink, IE const& ie)
 	{
 		d.m_sink.on_error(ex.what());
 	}
+#endif
 }
 
 } //namespace med
@@ -39,25 +39,37 @@ struct decoder : sl::octet_info
 	auto operator() (GET_STATE)                 { return get_context().buffer().get_state(); }
 	template <class IE>
 	bool operator() (CHECK_STATE, IE const&)    { return !get_context().buffer().empty(); }
-	void operator() (ADVANCE_STATE ss)          { get_context().buffer().template advance<ADVANCE_STATE>(ss.delta); }
+	MED_RESULT operator() (ADVANCE_STATE ss)
+	{
+		get_context().buffer().template advance<ADVANCE_STATE>(ss.delta);
+		MED_RETURN_ON_ERROR(*this);
+		MED_RETURN_SUCCESS;
+	}
+	template <class IE>
+	MED_RESULT operator() (SKIP_STATE ss, IE const&) { return get_context().buffer().template skip<IE>(ss.size); }
 
 	//IE_TAG
 	template <class IE> [[nodiscard]] auto operator() (IE&, IE_TAG)
 	{
 		CODEC_TRACE("TAG[%s]: %s", name<IE>(), get_context().buffer().toString());
 		as_writable_t<IE> ie;
-		(*this)(ie, typename as_writable_t<IE>::ie_type{});
+		(void)(*this)(ie, typename as_writable_t<IE>::ie_type{});
 		return ie.get_encoded();
 	}
 
+	//IE_LEN
+	template <class IE> MED_RESULT operator() (IE& ie, IE_LEN)
+		{ return (*this)(ie, typename IE::ie_type{}); }
+
 	//IE_VALUE
 	//Little Endian Base 128: https://en.wikipedia.org/wiki/LEB128
 	template <class IE>
-	void operator() (IE& ie, IE_VALUE)
+	MED_RESULT operator() (IE& ie, IE_VALUE)
 	{
 		static_assert(0 == (IE::traits::bits % 8), "OCTET VALUE EXPECTED");
 		CODEC_TRACE("->VAL[%s] %zu bits: %s", name<IE>(), IE::traits::bits, get_context().buffer().toString());
 		typename IE::value_type val = get_context().buffer().template pop<IE>();
+		MED_RETURN_ON_ERROR(*this);
 		if (val & 0x80)
 		{
 			val &= 0x7F;
@@ -67,6 +79,7 @@ struct decoder : sl::octet_info
 				if (++count < MAX_VARINT_BYTES)
 				{
 					auto const byte = get_context().buffer().template pop<IE>();
+					MED_RETURN_ON_ERROR(*this);
 					val |= static_cast<typename IE::value_type>(byte & 0x7F) << (7 * count);
 					if (0 == (byte & 0x80)) { break; }
 				}
@@ -89,17 +102,20 @@ struct decoder : sl::octet_info
 			ie.set_encoded(val);
 		}
 		CODEC_TRACE("<-VAL[%s]=%zX: %s", name<IE>(), std::size_t(val), get_context().buffer().toString());
+		MED_RETURN_SUCCESS;
 	}
 
 	//IE_OCTET_STRING
 	template <class IE>
-	void operator() (IE& ie, IE_OCTET_STRING)
+	MED_RESULT operator() (IE& ie, IE_OCTET_STRING)
 	{
 		CODEC_TRACE("STR[%s] <-(%zu bytes): %s", name<IE>(), get_context().buffer().size(), get_context().buffer().toString());
 		if (ie.set_encoded(get_context().buffer().size(), get_context().buffer().begin()))
 		{
 			CODEC_TRACE("STR[%s] -> len = %zu bytes", name<IE>(), std::size_t(ie.size()));
 			get_context().buffer().template advance<IE>(ie.size());
+			MED_RETURN_ON_ERROR(*this);
+			MED_RETURN_SUCCESS;
 		}
 		else
 		{
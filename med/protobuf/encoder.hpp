@@ -32,7 +32,7 @@ struct encoder : sl::octet_info
 	auto operator() (GET_STATE)                       { return get_context().buffer().get_state(); }
 	void operator() (SET_STATE, state_type const& st) { get_context().buffer().set_state(st); }
 	template <class IE>
-	void operator() (SET_STATE, IE const& ie)
+	MED_RESULT operator() (SET_STATE, IE const& ie)
 	{
 		if (auto const ss = get_context().get_snapshot(ie))
 		{
@@ -40,6 +40,7 @@ struct encoder : sl::octet_info
 			if (ss.validate_length(len))
 			{
 				get_context().buffer().set_state(ss);
+				MED_RETURN_SUCCESS;
 			}
 			else
 			{
@@ -55,39 +56,53 @@ struct encoder : sl::octet_info
 	template <class IE>
 	bool operator() (PUSH_STATE, IE const&)           { return get_context().buffer().push_state(); }
 	void operator() (POP_STATE)                       { get_context().buffer().pop_state(); }
-	void operator() (ADVANCE_STATE ss)                { get_context().buffer().template advance<ADVANCE_STATE>(ss.delta); }
-	void operator() (SNAPSHOT ss)                     { get_context().put_snapshot(ss); }
+	MED_RESULT operator() (ADVANCE_STATE ss)
+	{
+		get_context().buffer().template advance<ADVANCE_STATE>(ss.delta);
+		MED_RETURN_ON_ERROR(*this);
+		MED_RETURN_SUCCESS;
+	}
+	MED_RESULT operator() (SNAPSHOT ss)               { return get_context().put_snapshot(ss); }
 
 	//IE_TAG/IE_LEN
-	template <class IE> void operator() (IE const& ie, IE_TAG)
-		{ (*this)(ie, typename IE::ie_type{}); }
+	template <class IE> MED_RESULT operator() (IE const& ie, IE_TAG)
+		{ return (*this)(ie, typename IE::ie_type{}); }
+	template <class IE> MED_RESULT operator() (IE const& ie, IE_LEN)
+		{ return (*this)(ie, typename IE::ie_type{}); }
 
 	//IE_VALUE
 	//Little Endian Base 128: https://en.wikipedia.org/wiki/LEB128
 	template <class IE>
-	void operator() (IE const& ie, IE_VALUE)
+	MED_RESULT operator() (IE const& ie, IE_VALUE)
 	{
 		static_assert(0 == (IE::traits::bits % 8), "OCTET VALUE EXPECTED");
 		auto value = ie.get_encoded();
 		CODEC_TRACE("VAL[%s]=%#zX(%zu) %zu bits: %s", name<IE>(), std::size_t(value), std::size_t(value), IE::traits::bits, get_context().buffer().toString());
-		//TODO: estimate exact size needed? will it be faster?
+		//NOTE: size is estimated to advance once and write in order into any buffer
+		std::size_t num_bytes = 1;
+		for (auto v = value; v >= 0x80; v >>= 7) { ++num_bytes; }
+		uint8_t* out = get_context().buffer().template advance<IE>(num_bytes);
+		MED_RETURN_ON_ERROR(*this);
 		while (value >= 0x80)
 		{
-			get_context().buffer().template push<IE>(value | 0x80);
+			*out++ = uint8_t(value | 0x80);
 			CODEC_TRACE("\twrote %#02X, value=%#zX", uint8_t(value|0x80), std::size_t(value >> 7));
 			value >>= 7;
 		}
-		get_context().buffer().template push<IE>(value);
+		*out = uint8_t(value);
 		CODEC_TRACE("\twrote value %02X", uint8_t(value));
+		MED_RETURN_SUCCESS;
 	}
 
 	//IE_OCTET_STRING
 	template <class IE>
-	void operator() (IE const& ie, IE_OCTET_STRING)
+	MED_RESULT operator() (IE const& ie, IE_OCTET_STRING)
 	{
 		uint8_t* out = get_context().buffer().template advance<IE>(ie.size());
+		MED_RETURN_ON_ERROR(*this);
 		octets<IE::traits::min_octets, IE::traits::max_octets>::copy(out, ie.data(), ie.size());
 		CODEC_TRACE("STR[%s] %zu octets: %s", name<IE>(), ie.size(), get_context().buffer().toString());
+		MED_RETURN_SUCCESS;
 	}
 
 private:
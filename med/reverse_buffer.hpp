@@ -0,0 +1,180 @@
+/**
+@file
+buffer for encoding back-to-front
+
+@copyright Denis Priyomov 2016-2017
+Distributed under the MIT License
+(See accompanying file LICENSE or visit https://github.com/cppden/med)
+*/
+
+#pragma once
+
+#include "buffer.hpp"
+
+namespace med {
+
+/**
+ * Encoder buffer filled from the end towards the start.
+ * Each primitive is written in natural order into the space reserved by advance
+ * while the structure layer encodes IEs in reverse order: the value before its
+ * length and tag. So the length is known once its contents are written and no
+ * calculation pass over the nested IEs is needed which suits variable-width
+ * lengths like in ASN.1 BER or protobuf.
+ * The output is located at the end of the memory given (see get_start/used).
+ * NOTE: explicit meta-info, padding and snapshots are not supported.
+ */
+template <typename T = uint8_t> requires (sizeof(T) == 1 && std::is_integral_v<T> && !std::is_const_v<T>)
+class reverse_buffer
+{
+public:
+	using pointer = T*;
+	using value_type = T;
+	static constexpr auto is_const_v = false;
+	static constexpr bool reverse = true;
+
+	constexpr reverse_buffer() noexcept = default;
+
+	//captures current state of the buffer
+	class state_type
+	{
+	public:
+		constexpr explicit operator bool() const  { return nullptr != cursor; }
+		constexpr void reset(pointer p = nullptr) { cursor = p; }
+		constexpr operator pointer() const        { return cursor; }
+
+		//number of octets written from rhs to this state as with forward buffer
+		constexpr std::ptrdiff_t operator- (state_type const& rhs) const
+		{
+			return rhs.cursor - cursor;
+		}
+
+	private:
+		friend class reverse_buffer;
+
+		pointer cursor{nullptr};
+	};
+
+	constexpr void reset() noexcept                  { m_state.reset(m_end); m_error.reset(); }
+	constexpr void reset(void* p, std::size_t s) noexcept
+	{
+		m_start = static_cast<pointer>(p);
+		m_end = m_start + s;
+		reset();
+	}
+	template <typename U> requires (std::is_integral_v<U>)
+	constexpr void reset(std::span<U> p) noexcept           { reset(p.data(), p.size_bytes()); }
+	template <typename U, size_t SZ>
+	constexpr void reset(U (&p)[SZ]) noexcept               { reset(p, sizeof(p)); }
+
+	constexpr state_type get_state() const noexcept         { return m_state; }
+	constexpr void set_state(state_type const& st) noexcept { m_state = st; }
+
+	constexpr bool push_state()
+	{
+		if (not empty())
+		{
+			m_store = m_state;
+			return true;
+		}
+		m_store.reset();
+		return false;
+	}
+
+	constexpr void pop_state()
+	{
+		if (m_store)
+		{
+			m_state = m_store;
+			m_store.reset();
+		}
+	}
+
+	//start of the output encoded so far
+	constexpr pointer get_start() const noexcept            { return begin(); }
+	constexpr size_t get_offset() const noexcept            { return end() - begin(); }
+	constexpr std::span<value_type> used() const noexcept   { return {get_start(), get_offset()}; }
+	//space left before the output
+	constexpr size_t size() const noexcept                  { return begin() - m_start; }
+	constexpr bool empty() const noexcept                   { return begin() <= m_start; }
+	explicit constexpr operator bool() const noexcept       { return !empty(); }
+
+	template <class IE> constexpr MED_RESULT push(value_type v)
+	{
+		if (not empty()) { *--m_state.cursor = v; MED_RETURN_SUCCESS; }
+		else { MED_THROW_EXCEPTION(overflow, name<IE>(), sizeof(value_type), *this) }
+	}
+
+	//reserves space in front of the output to be written in natural order
+	template <class IE, size_t DELTA> constexpr pointer advance()
+	{
+		if (size() < DELTA) { MED_THROW_EXCEPTION(overflow, name<IE>(), DELTA, *this) }
+		m_state.cursor -= DELTA;
+		return begin();
+	}
+
+	template <class IE = void> constexpr pointer advance(int delta)
+	{
+		pointer p = nullptr;
+		if (delta >= 0 && size() >= std::size_t(delta))
+		{
+			m_state.cursor -= delta;
+			p = begin();
+		}
+		else if (delta < 0 && std::size_t(-delta) <= get_offset())
+		{
+			m_state.cursor -= delta;
+			p = begin();
+		}
+		else if constexpr (not std::is_void_v<IE>)
+		{
+			MED_THROW_EXCEPTION(overflow, name<IE>(), delta, *this)
+		}
+		return p;
+	}
+
+	template <class IE> constexpr MED_RESULT fill(std::size_t count, uint8_t value)
+	{
+		if (size() >= count)
+		{
+			while (count--) *--m_state.cursor = value;
+			MED_RETURN_SUCCESS;
+		}
+		else
+		{
+			MED_THROW_EXCEPTION(overflow, name<IE>(), count, *this)
+		}
+	}
+
+	constexpr pointer begin() const noexcept                { return m_state.cursor; }
+	constexpr pointer end() const noexcept                  { return m_end; }
+
+	char const* toString() const
+	{
+		static char sz[64];
+		int n = std::snprintf(sz, sizeof(sz), "%p@#%d-%zu=", (void*)begin(), int(size()), get_offset());
+		auto p = begin();
+		for (auto const to = std::min(get_offset(), std::size_t(10)); p != begin() + to; ++p)
+		{
+			n += std::snprintf(sz+n, sizeof(sz)-n, p == begin() ? "[%02X]":"%02X", *p);
+		}
+		return sz;
+	}
+
+	friend std::ostream& operator << (std::ostream& out, reverse_buffer const& buf)
+	{
+		return out << buf.toString();
+	}
+
+	//the 1st error occurred when exceptions are disabled (see MED_NO_EXCEPTION)
+	constexpr error_context& error_ctx() noexcept             { return m_error; }
+	constexpr error_context const& error_ctx() const noexcept { return m_error; }
+
+private:
+	state_type     m_state{};
+	pointer        m_end{};
+	pointer        m_start{nullptr};
+	state_type     m_store{};
+	error_context  m_error{};
+};
+
+}	//end: namespace med
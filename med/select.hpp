@@ -0,0 +1,231 @@
+/**
+@file
+selective decoding of the IEs given and validate-only decoding
+
+@copyright Denis Priyomov 2016-2017
+Distributed under the MIT License
+(See accompanying file LICENSE or visit https://github.com/cppden/med)
+*/
+
+#pragma once
+
+#include <type_traits>
+
+#include "concepts.hpp"
+#include "exception.hpp"
+#include "ie_type.hpp"
+#include "name.hpp"
+#include "state.hpp"
+#include "meta/typelist.hpp"
+
+namespace med {
+
+/**
+ * Decoder adaptor to decode only the IEs of the list (see decode<FIELDS...>).
+ * The selected IEs are decoded completely by the original decoder while the
+ * rest with length are skipped w/o decoding the value and the instances
+ * of multi-fields are not stored. IEs w/o length are decoded as usual.
+ * @tparam DECODER original decoder
+ * @tparam FIELDS list of IEs to decode
+ * @tparam ROOT IE being decoded
+ */
+template <class DECODER, class FIELDS, class ROOT>
+struct selective_decoder : DECODER
+{
+	using base_decoder = DECODER;
+	using fields_type = FIELDS;
+	using root_type = ROOT;
+
+	explicit constexpr selective_decoder(DECODER const& decoder) : DECODER{decoder} {}
+	constexpr DECODER& base() noexcept          { return *this; }
+};
+
+template <class DECODER>
+concept ASelectiveDecoder = requires
+{
+	typename DECODER::base_decoder;
+	typename DECODER::fields_type;
+	typename DECODER::root_type;
+};
+
+//IE is in the list to decode by the original decoder
+template <class DECODER, class IE>
+constexpr bool is_selected_v = false;
+template <ASelectiveDecoder DECODER, class IE>
+constexpr bool is_selected_v<DECODER, IE> = meta::list_index_of_v<get_field_type_t<IE>, typename DECODER::fields_type>
+	< meta::list_size_v<typename DECODER::fields_type>;
+
+//IE is skipped by its framing (only w/ length, the rest is decoded)
+template <class DECODER, class IE>
+constexpr bool is_skipped_v = false;
+template <ASelectiveDecoder DECODER, class IE>
+constexpr bool is_skipped_v<DECODER, IE> = !is_selected_v<DECODER, IE>
+	&& !std::is_same_v<get_field_type_t<IE>, typename DECODER::root_type>;
+
+/**
+ * Decoder adaptor to check the structure of encoded message only (see validate).
+ * The instances of multi-fields are counted to check the arity but not stored
+ * and the octet strings with internal storage are checked and skipped w/o copy.
+ * @tparam DECODER original decoder
+ */
+template <class DECODER>
+struct validating_decoder : DECODER
+{
+	using base_decoder = DECODER;
+	using DECODER::operator();
+
+	explicit constexpr validating_decoder(DECODER const& decoder) : DECODER{decoder} {}
+
+	//IE_OCTET_STRING with internal storage taking the rest of buffer
+	template <class IE> requires requires(IE& ie, DECODER& d) { IE::fits(0); ie.size(); d(SKIP_STATE{}, ie); }
+		&& (requires(IE& ie) { ie.emplace(); } || requires(IE& ie) { ie.emplace(0); })
+	constexpr MED_RESULT operator() (IE& ie, IE_OCTET_STRING)
+	{
+		auto const len = this->get_context().buffer().size();
+		if (not IE::fits(len)) { MED_THROW_EXCEPTION(invalid_value, name<IE>(), len, this->get_context().buffer()) }
+		if constexpr (requires { ie.emplace(); }) { ie.emplace(); }
+		else { ie.emplace(len); }
+		return (*this)(SKIP_STATE{ie.size()}, ie);
+	}
+};
+
+template <class DECODER>
+concept AValidatingDecoder = requires
+{
+	typename DECODER::base_decoder;
+	requires std::is_same_v<DECODER, validating_decoder<typename DECODER::base_decoder>>;
+};
+
+template <class... IES> struct sequence;
+template <class... IES> struct set;
+template <class... IES> class choice;
+template <AField FIELD> class cold;
+
+namespace detail {
+
+template <class FIELD> struct validation_stub;
+
+/*
+ * Shadow of IE to validate w/o message instance (see validate): nested
+ * containers are replaced by stubs (wrapped by M/O or cold too) while the
+ * rest (e.g. values referred by conditions or counters) is kept as is.
+ */
+template <class IE>
+struct shadow_ie
+{
+	using type = IE;
+};
+template <class IE>
+using shadow_ie_t = typename shadow_ie<IE>::type;
+
+//wrapper of field (e.g. M<T, L, FIELD>)
+template <template <class...> class WRAPPER, class... ARGS> requires AHasFieldType<WRAPPER<ARGS...>>
+struct shadow_ie<WRAPPER<ARGS...>>
+{
+	using type = WRAPPER<shadow_ie_t<ARGS>...>;
+};
+
+template <class FIELD> requires (AContainer<FIELD> && !AHasFieldType<FIELD>)
+struct shadow_ie<FIELD>
+{
+	using type = validation_stub<FIELD>;
+};
+
+//no allocation for cold IE as for any other
+template <class FIELD>
+struct shadow_ie<cold<FIELD>>
+{
+	using type = shadow_ie_t<FIELD>;
+};
+
+//compound header of set or choice is kept to dispatch by its tag
+template <class IE>
+using shadow_head_t = conditional_t<AHasGetTag<IE>, IE, shadow_ie_t<IE>>;
+
+template <class... IES>
+sequence<shadow_ie_t<IES>...>* shadow_of(sequence<IES...> const*);
+template <class IE, class... IES>
+set<shadow_head_t<IE>, shadow_ie_t<IES>...>* shadow_of(set<IE, IES...> const*);
+template <class IE, class... IES>
+choice<shadow_head_t<IE>, shadow_ie_t<IES>...>* shadow_of(choice<IE, IES...> const*);
+
+//container of the same kind with shadows of its IEs
+template <class FIELD>
+using shadow_t = std::remove_pointer_t<decltype(shadow_of(static_cast<FIELD const*>(nullptr)))>;
+
+/**
+ * Container in place of IE which is decoded into its shadow on stack only
+ * while being validated so the nested containers take no space in the shadow
+ * of their parent. It's found by the original type (e.g. by presence condition)
+ * but its IEs are not accessible.
+ * @tparam FIELD container to validate
+ */
+template <class FIELD>
+struct validation_stub
+{
+	using field_type  = FIELD;
+	using ie_type     = typename FIELD::ie_type;
+	using meta_info   = get_meta_info_t<FIELD>;
+	using shadow_type = shadow_t<FIELD>;
+	using ies_types   = typename shadow_type::ies_types;
+
+	constexpr bool is_set() const noexcept          { return m_set; }
+	constexpr void clear() noexcept                 { m_set = false; }
+
+	template <class... TYPE_CTX>
+	constexpr MED_RESULT decode(auto& decoder, auto&... deps)
+	{
+		shadow_type shadow;
+		if constexpr (sizeof...(TYPE_CTX) == 0)
+		{
+			MED_CHECK_FAIL(shadow.decode(decoder, deps...));
+		}
+		else
+		{
+			MED_CHECK_FAIL((shadow.template decode<TYPE_CTX...>(decoder, deps...)));
+		}
+		m_set = shadow.is_set();
+		MED_RETURN_SUCCESS;
+	}
+
+private:
+	bool m_set {false};
+};
+
+} //end: namespace detail
+
+namespace sl {
+
+//place to decode instances of multi-field into
+template <class DECODER, class IE>
+struct field_sink
+{
+	constexpr auto* push_back(IE& ie, DECODER& decoder)     { return ie.push_back(decoder); }
+	constexpr MED_RESULT reserve(IE& ie, std::size_t num, DECODER& decoder) { return ie.reserve(num, decoder); }
+};
+
+//the same instance when skipped
+template <class DECODER, class IE> requires is_skipped_v<DECODER, IE>
+struct field_sink<DECODER, IE>
+{
+	constexpr auto* push_back(IE&, DECODER&)
+	{
+		m_field.clear();
+		return &m_field;
+	}
+	constexpr MED_RESULT reserve(IE&, std::size_t, DECODER&) { MED_RETURN_SUCCESS; }
+
+	typename IE::field_type m_field;
+};
+
+//counted in the 1st slot when validated
+template <AValidatingDecoder DECODER, class IE>
+struct field_sink<DECODER, IE>
+{
+	constexpr auto* push_back(IE& ie, DECODER&)             { return ie.push_counted(); }
+	constexpr MED_RESULT reserve(IE&, std::size_t, DECODER&) { MED_RETURN_SUCCESS; }
+};
+
+} //end: namespace sl
+
+} //end: namespace med
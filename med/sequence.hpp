@@ -14,6 +14,7 @@ Distributed under the MIT License
 #include "container.hpp"
 #include "encode.hpp"
 #include "decode.hpp"
+#include "layout.hpp"
 #include "debug.hpp"
 #include "meta/typelist.hpp"
 #include "meta/foreach.hpp"
@@ -33,31 +34,67 @@ constexpr void discard(auto& func, auto& vtag)
 }
 
 template <class FUNC, class IE>
-constexpr void encode_multi(FUNC& func, IE const& ie)
+constexpr MED_RESULT encode_multi(FUNC& func, IE const& ie)
 {
 	using mi = meta::produce_info_t<FUNC, typename IE::field_type>; //assuming MI of multi_field == MI of field
 	using ctx = type_context<typename IE::ie_type, mi>;
 
 	CODEC_TRACE("%s *%zu", name<IE>(), ie.count());
-	for (auto& field : ie)
+	return foreach_field<FUNC>(ie, [&func, &ie](auto const& field) -> MED_RESULT
 	{
 		CODEC_TRACE("[%s]%c", name<IE>(), field.is_set() ? '+':'-');
 		if (field.is_set())
 		{
-			ie_encode<ctx>(func, field);
+			return ie_encode<ctx>(func, field);
 		}
 		else
 		{
-			MED_THROW_EXCEPTION(missing_ie, name<IE>(), ie.count(), ie.count() - 1)
+			MED_THROW_EXCEPTION(missing_ie, name<IE>(), ie.count(), ie.count() - 1, func)
 		}
+	});
+}
+
+//codec checks the space once for the run of fixed-size IEs (see fixed_run_size)
+template <class CODEC, class IE>
+concept ARunCodec = detail::AFixedRun<IE> && requires(CODEC& codec, IE& ie)
+{
+	codec(CHECK_SIZE{}, ie);
+	codec(ie, IE_VALUE{}, UNCHECKED{});
+};
+
+//IE is coded w/o checks as a part of run
+template <class CODEC, class PREV_IE, class IE, class TO>
+constexpr bool is_in_run_v = false;
+template <class CODEC, class PREV_IE, class IE, class TO> requires ARunCodec<CODEC, IE>
+constexpr bool is_in_run_v<CODEC, PREV_IE, IE, TO> = in_fixed_run<PREV_IE, IE, typename TO::ies_types>
+	|| fixed_run_size<IE, typename TO::ies_types> > 0;
+
+template <class PREV_IE, class IE, class TO>
+constexpr MED_RESULT check_run(auto& codec, IE const& ie)
+{
+	if constexpr (in_fixed_run<PREV_IE, IE, typename TO::ies_types>)
+	{
+		MED_RETURN_SUCCESS;
+	}
+	else
+	{
+		constexpr auto size = fixed_run_size<IE, typename TO::ies_types>;
+		CODEC_TRACE("run of %zu octets from %s", size, name<IE>());
+		return codec(CHECK_SIZE{size}, ie);
 	}
 }
 
 struct seq_dec
 {
 	template <class CTX, class PREV_IE, class IE, class TO, class DECODER>
-	static constexpr void apply(TO& to, DECODER& decoder, auto& vtag, auto&... deps)
+	static constexpr MED_RESULT apply(TO& to, DECODER& decoder, auto& vtag, auto&... deps)
 	{
+		if constexpr (is_selected_v<DECODER, IE>)
+		{
+			//decoded completely by the original decoder
+			return apply<CTX, PREV_IE, IE>(to, decoder.base(), vtag, deps...);
+		}
+
 		IE& ie = to;
 		using mi = meta::produce_info_t<DECODER, IE>;
 		using type = get_meta_tag_t<mi>;
@@ -68,6 +105,7 @@ struct seq_dec
 		if constexpr (AMultiField<IE>)
 		{
 			CODEC_TRACE("[%s]*", name<IE>());
+			field_sink<DECODER, IE> sink;
 			if constexpr (not std::is_void_v<type>) //multi-field with tag
 			{
 				//multi-instance optional or mandatory field w/ tag w/o counter
@@ -76,19 +114,22 @@ struct seq_dec
 				if (!vtag && decoder(PUSH_STATE{}, ie))
 				{
 					vtag.set_encoded(decode_tag<type>(decoder));
+					MED_RETURN_ON_ERROR(decoder);
 					CODEC_TRACE("pop tag=%zX", vtag.get_encoded());
 				}
 
 				while (type::match(vtag.get_encoded()))
 				{
 					CODEC_TRACE("->T=%zX[%s]*%zu", vtag.get_encoded(), name<IE>(), ie.count()+1);
-					auto* field = ie.push_back(decoder);
+					auto* field = sink.push_back(ie, decoder);
+					MED_RETURN_ON_ERROR(decoder);
 					using ctx_next = type_context<typename CTX::ie_type, meta::list_rest_t<mi>, EXP_TAG, EXP_LEN>;
-					ie_decode<ctx_next>(decoder, *field, deps...);
+					MED_CHECK_FAIL(ie_decode<ctx_next>(decoder, *field, deps...));
 
 					if (decoder(PUSH_STATE{}, ie)) //not at the end
 					{
 						vtag.set_encoded(decode_tag<type>(decoder));
+						MED_RETURN_ON_ERROR(decoder);
 						CODEC_TRACE("pop tag=%zX", vtag.get_encoded());
 					}
 					else //end is reached
@@ -100,7 +141,7 @@ struct seq_dec
 				}
 
 				if (!vtag) { decoder(POP_STATE{}); } //restore state
-				check_arity(decoder, ie);
+				return check_arity(decoder, ie);
 			}
 			else //multi-field w/o tag
 			{
@@ -119,19 +160,24 @@ struct seq_dec
 						else
 						{
 							typename IE::counter_type counter_ie;
-							ie_decode<type_context<typename CTX::ie_type>>(decoder, counter_ie);
+							(void)ie_decode<type_context<typename CTX::ie_type>>(decoder, counter_ie);
 							return counter_ie.get_encoded();
 						}
 					}();
+					MED_RETURN_ON_ERROR(decoder);
 
 					CODEC_TRACE("[%s] CNT=%zu", name<IE>(), std::size_t(count));
-					check_arity(decoder, ie, count);
+					MED_CHECK_FAIL(check_arity(decoder, ie, count));
+					//all instances at once instead of growing by one
+					MED_CHECK_FAIL(sink.reserve(ie, ie.count() + count, decoder));
 					while (count--)
 					{
-						auto* field = ie.push_back(decoder);
+						auto* field = sink.push_back(ie, decoder);
+						MED_RETURN_ON_ERROR(decoder);
 						CODEC_TRACE("#%zu = %p", std::size_t(count), (void*)field);
-						med::decode(decoder, *field, deps...);
+						MED_CHECK_FAIL(med::decode(decoder, *field, deps...));
 					}
+					MED_RETURN_SUCCESS;
 				}
 				else if constexpr (AHasCondition<IE>) //conditional multi-field
 				{
@@ -140,16 +186,18 @@ struct seq_dec
 						do
 						{
 							CODEC_TRACE("C[%s]#%zu", name<IE>(), ie.count());
-							auto* field = ie.push_back(decoder);
-							med::decode(decoder, *field, deps...);
+							auto* field = sink.push_back(ie, decoder);
+							MED_RETURN_ON_ERROR(decoder);
+							MED_CHECK_FAIL(med::decode(decoder, *field, deps...));
 						}
 						while (typename IE::condition{}(to));
 
-						check_arity(decoder, ie);
+						return check_arity(decoder, ie);
 					}
 					else
 					{
 						CODEC_TRACE("skipped C[%s]", name<IE>());
+						MED_RETURN_SUCCESS;
 					}
 				}
 				else
@@ -158,12 +206,13 @@ struct seq_dec
 					std::size_t count = 0;
 					while (decoder(CHECK_STATE{}, ie) && count < IE::max)
 					{
-						auto* field = ie.push_back(decoder);
-						ie_decode<ctx>(decoder, *field, deps...);
+						auto* field = sink.push_back(ie, decoder);
+						MED_RETURN_ON_ERROR(decoder);
+						MED_CHECK_FAIL(ie_decode<ctx>(decoder, *field, deps...));
 						++count;
 					}
 
-					check_arity(decoder, ie);
+					return check_arity(decoder, ie);
 				}
 			}
 		}
@@ -182,12 +231,13 @@ struct seq_dec
 						{
 							//don't save state as we just did it already
 							vtag.set_encoded(decode_tag<type>(decoder));
+							MED_RETURN_ON_ERROR(decoder);
 							CODEC_TRACE("read tag=%zX", std::size_t(vtag.get_encoded()));
 						}
 						else
 						{
 							CODEC_TRACE("EoF at %s", name<IE>());
-							return; //end of buffer
+							MED_RETURN_SUCCESS; //end of buffer
 						}
 					}
 
@@ -196,8 +246,9 @@ struct seq_dec
 						CODEC_TRACE("T=%zX[%s]", std::size_t(vtag.get_encoded()), name<IE>());
 						vtag.clear(); //clear current tag as decoded
 						using ctx_next = type_context<typename CTX::ie_type, meta::list_rest_t<mi>, EXP_TAG, EXP_LEN>;
-						ie_decode<ctx_next>(decoder, ie, deps...);
+						return ie_decode<ctx_next>(decoder, ie, deps...);
 					}
+					MED_RETURN_SUCCESS;
 				}
 				else //optional w/o tag
 				{
@@ -215,11 +266,12 @@ struct seq_dec
 						if (was_set)
 						{
 							CODEC_TRACE("C[%s]", name<IE>());
-							ie_decode<ctx>(decoder, ie, deps...);
+							return ie_decode<ctx>(decoder, ie, deps...);
 						}
 						else
 						{
 							CODEC_TRACE("skipped C[%s]", name<IE>());
+							MED_RETURN_SUCCESS;
 						}
 					}
 					else //optional field w/o tag (optional by end of data)
@@ -227,12 +279,12 @@ struct seq_dec
 						CODEC_TRACE("[%s]...", name<IE>());
 						if (decoder(CHECK_STATE{}, ie))
 						{
-							ie_decode<ctx>(decoder, ie, deps...);
+							return ie_decode<ctx>(decoder, ie, deps...);
 						}
 						else
 						{
 							CODEC_TRACE("EOF at [%s]", name<IE>());
-							return; //end of buffer
+							MED_RETURN_SUCCESS; //end of buffer
 						}
 					}
 				}
@@ -247,16 +299,65 @@ struct seq_dec
 				{
 					discard(decoder, vtag);
 				}
-				ie_decode<ctx>(decoder, ie, deps...);
+				//explicit length shrinks the buffer in the middle of run
+				if constexpr (is_in_run_v<DECODER, PREV_IE, IE, TO> && std::is_void_v<EXP_LEN> && sizeof...(deps) == 0)
+				{
+					MED_CHECK_FAIL((check_run<PREV_IE, IE, TO>(decoder, ie)));
+					return decoder(ie, IE_VALUE{}, UNCHECKED{});
+				}
+				else
+				{
+					return ie_decode<ctx>(decoder, ie, deps...);
+				}
 			}
 		}
 	}
 };
 
+//decodes IEs from the resume point memorizing the last one fully decoded (see stream_decoder)
+template <class RESUME>
+struct seq_dec_resume
+{
+	template <class CTX, class PREV_IE, class IE, class TO, class DECODER>
+	constexpr MED_RESULT apply(TO& to, DECODER& decoder, auto& vtag)
+	{
+		auto const index = m_index++;
+		if (index < m_resume.index()) { MED_RETURN_SUCCESS; } //decoded already
+		static_cast<IE&>(to).clear(); //drop decoded by failed attempt (resume point may lag by read-ahead tag)
+
+		MED_CHECK_FAIL((seq_dec::apply<CTX, PREV_IE, IE>(to, decoder, vtag)));
+		//can't resume with a tag read ahead
+		if (!vtag) { m_resume.checkpoint(m_index, decoder(GET_STATE{})); }
+		MED_RETURN_SUCCESS;
+	}
+
+	RESUME&     m_resume;
+	std::size_t m_index{0};
+};
+
 struct seq_enc
 {
+	//counter precedes the fields
+	template <class IE>
+	static constexpr MED_RESULT encode_counted(auto& encoder, IE const& ie)
+	{
+		typename IE::counter_type counter_ie;
+		counter_ie.set_encoded(ie.count());
+		MED_CHECK_FAIL(check_arity(encoder, ie));
+		if constexpr (AReverseEncoder<std::remove_reference_t<decltype(encoder)>>)
+		{
+			MED_CHECK_FAIL(encode_multi(encoder, ie));
+			return med::encode(encoder, counter_ie);
+		}
+		else
+		{
+			MED_CHECK_FAIL(med::encode(encoder, counter_ie));
+			return encode_multi(encoder, ie);
+		}
+	}
+
 	template <class CTX, class PREV_IE, class IE>
-	static constexpr void apply(auto const& to, auto& encoder)
+	static constexpr MED_RESULT apply(auto const& to, auto& encoder)
 	{
 		IE const& ie = to;
 		if constexpr (AMultiField<IE>)
@@ -270,28 +371,21 @@ struct seq_enc
 					CODEC_TRACE("CV[%s]=%zu", name<IE>(), ie.count());
 					if (count > 0)
 					{
-						typename IE::counter_type counter_ie;
-						counter_ie.set_encoded(ie.count());
-						check_arity(encoder, ie);
-						med::encode(encoder, counter_ie);
-						encode_multi(encoder, ie);
+						return encode_counted(encoder, ie);
 					}
+					MED_RETURN_SUCCESS;
 				}
 				//mandatory multi-field w/ counter w/o tag
 				else
 				{
 					CODEC_TRACE("CV{%s}=%zu", name<IE>(), ie.count());
-					typename IE::counter_type counter_ie;
-					counter_ie.set_encoded(ie.count());
-					check_arity(encoder, ie);
-					med::encode(encoder, counter_ie);
-					encode_multi(encoder, ie);
+					return encode_counted(encoder, ie);
 				}
 			}
 			else //multi-field w/o counter
 			{
-				encode_multi(encoder, ie);
-				check_arity(encoder, ie);
+				MED_CHECK_FAIL(encode_multi(encoder, ie));
+				return check_arity(encoder, ie);
 			}
 		}
 		else //single-instance field
@@ -309,7 +403,7 @@ struct seq_enc
 					{
 						if (not setter(ie, to))
 						{
-							MED_THROW_EXCEPTION(invalid_value, name<IE>(), ie.get())
+							MED_THROW_EXCEPTION(invalid_value, name<IE>(), ie.get(), encoder)
 						}
 					}
 					else
@@ -319,16 +413,18 @@ struct seq_enc
 
 					if (ie.is_set())
 					{
-						med::encode(encoder, ie);
+						return med::encode(encoder, ie);
 					}
+					MED_RETURN_SUCCESS;
 				}
 				else //w/o setter
 				{
 					CODEC_TRACE("%c[%s]", ie.is_set()?'+':'-', name<IE>());
 					if (ie.is_set())
 					{
-						med::encode(encoder, ie);
+						return med::encode(encoder, ie);
 					}
+					MED_RETURN_SUCCESS;
 				}
 			}
 			else //mandatory field
@@ -344,7 +440,7 @@ struct seq_enc
 					{
 						if (not setter(ie, to))
 						{
-							MED_THROW_EXCEPTION(invalid_value, name<IE>(), ie.get())
+							MED_THROW_EXCEPTION(invalid_value, name<IE>(), ie.get(), encoder)
 						}
 					}
 					else
@@ -353,11 +449,11 @@ struct seq_enc
 					}
 					if (ie.is_set())
 					{
-						med::encode(encoder, ie);
+						return med::encode(encoder, ie);
 					}
 					else
 					{
-						MED_THROW_EXCEPTION(missing_ie, name<IE>(), 1, 0)
+						MED_THROW_EXCEPTION(missing_ie, name<IE>(), 1, 0, encoder)
 					}
 				}
 				else //w/o setter
@@ -365,11 +461,21 @@ struct seq_enc
 					CODEC_TRACE("%c{%s}", ie.is_set()?'+':'-', class_name<IE>());
 					if (AHasSetLength<IE> || ie.is_set())
 					{
-						med::encode(encoder, ie);
+						using encoder_t = std::remove_reference_t<decltype(encoder)>;
+						using to_t = std::remove_cvref_t<decltype(to)>;
+						if constexpr (is_in_run_v<encoder_t, PREV_IE, IE, to_t> && !AReverseEncoder<encoder_t>)
+						{
+							MED_CHECK_FAIL((check_run<PREV_IE, IE, to_t>(encoder, ie)));
+							return encoder(ie, IE_VALUE{}, UNCHECKED{});
+						}
+						else
+						{
+							return med::encode(encoder, ie);
+						}
 					}
 					else
 					{
-						MED_THROW_EXCEPTION(missing_ie, name<IE>(), 1, 0)
+						MED_THROW_EXCEPTION(missing_ie, name<IE>(), 1, 0, encoder)
 					}
 				}
 			}
@@ -386,19 +492,34 @@ struct sequence : container<IE_SEQUENCE, IES...>
 	using ies_types = typename container<IE_SEQUENCE, IES...>::ies_types;
 
 	template <class IE_LIST>
-	void encode(auto& encoder) const
+	MED_RESULT encode(auto& encoder) const
 	{
-		meta::foreach_prev<IE_LIST, void>(sl::seq_enc{}, this->m_ies, encoder);
+		if constexpr (sl::AReverseEncoder<std::remove_reference_t<decltype(encoder)>>)
+		{
+			return meta::foreach_prev<meta::list_reverse_t<IE_LIST>, void>(sl::seq_enc{}, this->m_ies, encoder);
+		}
+		else
+		{
+			return meta::foreach_prev<IE_LIST, void>(sl::seq_enc{}, this->m_ies, encoder);
+		}
 	}
-	void encode(auto& encoder) const { encode<ies_types>(encoder); }
+	MED_RESULT encode(auto& encoder) const { return encode<ies_types>(encoder); }
 
 	template <class IE_LIST, class TYPE_CTX = type_context<IE_SEQUENCE>>
-	void decode(auto& decoder, auto&... deps)
+	MED_RESULT decode(auto& decoder, auto&... deps)
+	{
+		value<std::size_t> vtag;
+		return meta::foreach_prev<IE_LIST, TYPE_CTX>(sl::seq_dec{}, this->m_ies, decoder, vtag, deps...);
+	}
+	MED_RESULT decode(auto& decoder, auto&... deps) { return decode<ies_types>(decoder, deps...); }
+
+	//decodes skipping IEs before the resume point (see stream_decoder)
+	template <class RESUME>
+	MED_RESULT decode_resume(auto& decoder, RESUME& resume)
 	{
 		value<std::size_t> vtag;
-		meta::foreach_prev<IE_LIST, TYPE_CTX>(sl::seq_dec{}, this->m_ies, decoder, vtag, deps...);
+		return meta::foreach_prev<ies_types, type_context<IE_SEQUENCE>>(sl::seq_dec_resume<RESUME>{resume}, this->m_ies, decoder, vtag);
 	}
-	void decode(auto& decoder, auto&... deps) { decode<ies_types>(decoder, deps...); }
 };
 
 } //end: namespace med
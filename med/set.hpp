@@ -17,6 +17,7 @@ Distributed under the MIT License
 #include "decode.hpp"
 #include "name.hpp"
 #include "tag.hpp"
+#include "tag_dispatch.hpp"
 #include "meta/unique.hpp"
 
 namespace med {
@@ -24,7 +25,7 @@ namespace med {
 namespace sl {
 
 template <class FUNC, class IE>
-inline constexpr void encode_single(FUNC& func, IE const& ie)
+inline constexpr MED_RESULT encode_single(FUNC& func, IE const& ie)
 {
 	if (ie.is_set())
 	{
@@ -35,18 +36,19 @@ inline constexpr void encode_single(FUNC& func, IE const& ie)
 		if constexpr (explicit_meta)
 		{
 			using ctx = type_context<IE_SET, meta::list_rest_t<mi>>;
-			sl::ie_encode<ctx>(func, ie);
+			return sl::ie_encode<ctx>(func, ie);
 		}
 		else
 		{
 			using ctx = type_context<IE_SET, mi>;
-			sl::ie_encode<ctx>(func, ie);
+			return sl::ie_encode<ctx>(func, ie);
 		}
 	}
 	else if constexpr (!AOptional<IE>)
 	{
-		MED_THROW_EXCEPTION(missing_ie, name<IE>(), 1, 0)
+		MED_THROW_EXCEPTION(missing_ie, name<IE>(), 1, 0, func)
 	}
+	MED_RETURN_SUCCESS;
 }
 
 struct set_name
@@ -75,7 +77,7 @@ struct set_name
 struct set_enc
 {
 	template <class CTX, class PREV_IE, class IE, class TO, class ENCODER>
-	static constexpr void apply(TO const& to, ENCODER& encoder)
+	static constexpr MED_RESULT apply(TO const& to, ENCODER& encoder)
 	{
 		IE const& ie = to;
 
@@ -85,24 +87,24 @@ struct set_enc
 			constexpr bool explicit_meta = explicit_meta_in<mi, get_field_type_t<IE>>();
 
 			CODEC_TRACE("[%s]*%zu: %s", name<IE>(), ie.count(), class_name<mi>());
-			check_arity(encoder, ie);
+			MED_CHECK_FAIL(check_arity(encoder, ie));
 
-			for (auto& field : ie)
+			return foreach_field<ENCODER>(ie, [&encoder, &ie](auto const& field) -> MED_RESULT
 			{
 				//field was pushed but not set... do we need a new error?
-				if (not field.is_set()) { MED_THROW_EXCEPTION(missing_ie, name<IE>(), ie.count(), ie.count()-1) }
+				if (not field.is_set()) { MED_THROW_EXCEPTION(missing_ie, name<IE>(), ie.count(), ie.count()-1, encoder) }
 
 				if constexpr (explicit_meta)
 				{
 					using ctx = type_context<IE_SET, meta::list_rest_t<mi>, get_info_t<meta::list_first_t<mi>>>;
-					sl::ie_encode<ctx>(encoder, field);
+					return sl::ie_encode<ctx>(encoder, field);
 				}
 				else
 				{
 					using ctx = type_context<IE_SET, mi>;
-					sl::ie_encode<ctx>(encoder, field);
+					return sl::ie_encode<ctx>(encoder, field);
 				}
-			}
+			});
 		}
 		else //single-instance field
 		{
@@ -117,18 +119,18 @@ struct set_enc
 				{
 					if (not setter(ie, to))
 					{
-						MED_THROW_EXCEPTION(invalid_value, name<IE>(), ie.get())
+						MED_THROW_EXCEPTION(invalid_value, name<IE>(), ie.get(), encoder)
 					}
 				}
 				else
 				{
 					setter(ie, to);
 				}
-				encode_single(encoder, ie);
+				return encode_single(encoder, ie);
 			}
 			else
 			{
-				encode_single(encoder, ie);
+				return encode_single(encoder, ie);
 			}
 		}
 	}
@@ -146,8 +148,14 @@ struct set_dec
 	}
 
 	template <class IE, class TO, class DECODER, class HEADER, class... DEPS>
-	static constexpr void apply(TO& to, DECODER& decoder, HEADER const&, DEPS&... deps)
+	static constexpr MED_RESULT apply(TO& to, DECODER& decoder, HEADER const& header, DEPS&... deps)
 	{
+		if constexpr (is_selected_v<DECODER, IE>)
+		{
+			//decoded completely by the original decoder
+			return apply<IE>(to, decoder.base(), header, deps...);
+		}
+
 		using mi = meta::produce_info_t<DECODER, IE>;
 		//pop back the tag we've read as we have non-fixed tag inside
 		using tag_t = get_info_t<meta::list_first_t<mi>>;
@@ -159,10 +167,12 @@ struct set_dec
 			CODEC_TRACE("[%s]*%zu", name<IE>(), ie.count());
 			if (ie.count() >= IE::max)
 			{
-				MED_THROW_EXCEPTION(extra_ie, name<IE>(), IE::max, ie.count())
+				MED_THROW_EXCEPTION(extra_ie, name<IE>(), IE::max, ie.count(), decoder)
 			}
-			auto* field = ie.push_back(decoder);
-			sl::ie_decode<type_context<IE_SET, meta::list_rest_t<mi>>>(decoder, *field, deps...);
+			field_sink<DECODER, IE> sink;
+			auto* field = sink.push_back(ie, decoder);
+			MED_RETURN_ON_ERROR(decoder);
+			return sl::ie_decode<type_context<IE_SET, meta::list_rest_t<mi>>>(decoder, *field, deps...);
 		}
 		else //single-instance field
 		{
@@ -172,32 +182,33 @@ struct set_dec
 				return sl::ie_decode<type_context<IE_SET, meta::list_rest_t<mi>>>(decoder, ie, deps...);
 				//return med::decode(decoder, ie);
 			}
-			MED_THROW_EXCEPTION(extra_ie, name<IE>(), 2, 1)
+			MED_THROW_EXCEPTION(extra_ie, name<IE>(), 2, 1, decoder)
 		}
 	}
 
 	template <class TO, class DECODER, class HEADER, class... DEPS>
-	static constexpr void apply(TO&, DECODER&, HEADER const& header, DEPS&...)
+	static constexpr MED_RESULT apply(TO&, DECODER& decoder, HEADER const& header, DEPS&...)
 	{
-		MED_THROW_EXCEPTION(unknown_tag, name<TO>(), get_tag(header))
+		MED_THROW_EXCEPTION(unknown_tag, name<TO>(), get_tag(header), decoder)
 	}
 };
 
 struct set_check
 {
 	template <class IE, class TO, class DECODER>
-	static constexpr void apply(TO const& to, DECODER& decoder)
+	static constexpr MED_RESULT apply(TO const& to, DECODER& decoder)
 	{
 		IE const& ie = to;
-		if constexpr (AMultiField<IE>)
+		if constexpr (is_skipped_v<DECODER, IE>) { MED_RETURN_SUCCESS; }
+		else if constexpr (AMultiField<IE>)
 		{
-			check_arity(decoder, ie);
+			MED_CHECK_FAIL(check_arity(decoder, ie));
 		}
 		else //single-instance field
 		{
 			if (not (AOptional<IE> || ie.is_set()))
 			{
-				MED_THROW_EXCEPTION(missing_ie, name<IE>(), 1, 0)
+				MED_THROW_EXCEPTION(missing_ie, name<IE>(), 1, 0, decoder)
 			}
 		}
 
@@ -207,14 +218,15 @@ struct set_check
 			if (ie.is_set() != should_be_set)
 			{
 				CODEC_TRACE("%cC[%s] %s be set in %s", ie.is_set() ? '+' : '-', name<IE>(), should_be_set ? "MUST" : "must NOT", name<TO>());
-				if (should_be_set) { MED_THROW_EXCEPTION(missing_ie, name<IE>(), 1, 0); }
-				else               { MED_THROW_EXCEPTION(extra_ie,   name<IE>(), 0, 1); }
+				if (should_be_set) { MED_THROW_EXCEPTION(missing_ie, name<IE>(), 1, 0, decoder); }
+				else               { MED_THROW_EXCEPTION(extra_ie,   name<IE>(), 0, 1, decoder); }
 			}
 		}
+		MED_RETURN_SUCCESS;
 	}
 
 	template <class TO, class DECODER>
-	static constexpr void apply(TO const&, DECODER&) {}
+	static constexpr MED_RESULT apply(TO const&, DECODER&) { MED_RETURN_SUCCESS; }
 };
 
 }	//end: namespace sl
@@ -249,13 +261,20 @@ struct set : detail::set_container<meta::typelist<IEs...>>
 	}
 
 	template <class ENCODER>
-	void encode(ENCODER& encoder) const
+	MED_RESULT encode(ENCODER& encoder) const
 	{
-		meta::foreach_prev<ies_types, void>(sl::set_enc{}, this->m_ies, encoder);
+		if constexpr (sl::AReverseEncoder<ENCODER>)
+		{
+			return meta::foreach_prev<meta::list_reverse_t<ies_types>, void>(sl::set_enc{}, this->m_ies, encoder);
+		}
+		else
+		{
+			return meta::foreach_prev<ies_types, void>(sl::set_enc{}, this->m_ies, encoder);
+		}
 	}
 
 	template <class DECODER, class... DEPS>
-	void decode(DECODER& decoder, DEPS&... deps)
+	MED_RESULT decode(DECODER& decoder, DEPS&... deps)
 	{
 		static_assert(std::is_void_v<meta::unique_t<tag_getter<DECODER>, ies_types>>
 			, "SEE ERROR ON INCOMPLETE TYPE/UNDEFINED TEMPLATE HOLDING IEs WITH CLASHED TAGS");
@@ -271,8 +290,9 @@ struct set : detail::set_container<meta::typelist<IEs...>>
 			{
 				value<std::size_t> header;
 				header.set_encoded(sl::decode_tag<tag_t>(decoder));
+				MED_RETURN_ON_ERROR(decoder);
 				CODEC_TRACE("tag=%#zX mi=%s firstIE=%s tag_t=%s", std::size_t(get_tag(header)), class_name<mi>(), name<IE>(), name<tag_t>());
-				meta::for_if<ies_types>(sl::set_dec{}, this->m_ies, decoder, header, deps...);
+				MED_CHECK_FAIL((tag_dispatch<DECODER, ies_types>(get_tag(header), sl::set_dec{}, this->m_ies, decoder, header, deps...)));
 			}
 		}
 		else //compound header
@@ -281,13 +301,13 @@ struct set : detail::set_container<meta::typelist<IEs...>>
 			while (decoder(PUSH_STATE{}, *this))
 			{
 				header_type header;
-				med::decode(decoder, header, deps...);
+				MED_CHECK_FAIL(med::decode(decoder, header, deps...));
 				decoder(POP_STATE{}); //restore back for IE to decode itself (?TODO: better to copy instead)
 				CODEC_TRACE("tag=%#zX hdr=%s", std::size_t(get_tag(header)), class_name<header_type>());
-				meta::for_if<ies_types>(sl::set_dec{}, this->m_ies, decoder, header, deps...);
+				MED_CHECK_FAIL((tag_dispatch<DECODER, ies_types>(get_tag(header), sl::set_dec{}, this->m_ies, decoder, header, deps...)));
 			}
 		}
-		meta::foreach<ies_types>(sl::set_check{}, this->m_ies, decoder);
+		return meta::foreach<ies_types>(sl::set_check{}, this->m_ies, decoder);
 	}
 };
 
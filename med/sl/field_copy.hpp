@@ -24,6 +24,7 @@ constexpr void field_copy(IE& to, IE const& from, ARGS&&... args)
 			for (auto const& rhs : from)
 			{
 				auto* p = to.push_back(std::forward<ARGS>(args)...);
+				if (!p) { return; } //out of memory w/o exceptions
 				p->copy(rhs, std::forward<ARGS>(args)...);
 			}
 		}
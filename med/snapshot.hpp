@@ -11,6 +11,7 @@ Distributed under the MIT License
 
 #include "length.hpp"
 #include "state.hpp"
+#include "meta/typelist.hpp"
 
 namespace med {
 
@@ -19,12 +20,37 @@ namespace med {
 //NOTE: requires IE to have name() defined!
 struct with_snapshot {};
 
+//IE with snapshot or container of such IEs
+template <class FIELD>
+constexpr bool has_snapshot()
+{
+	if constexpr (std::is_base_of_v<with_snapshot, FIELD>)
+	{
+		return true;
+	}
+	else if constexpr (requires { typename FIELD::ies_types; })
+	{
+		return []<class... IEs>(meta::typelist<IEs...>*)
+		{
+			return (false || ... || has_snapshot<get_field_type_t<IEs>>());
+		}(static_cast<typename FIELD::ies_types*>(nullptr));
+	}
+	else
+	{
+		return false;
+	}
+}
+
 template <class FUNC, class IE>
-constexpr void put_snapshot(FUNC& func, IE& ie)
+constexpr MED_RESULT put_snapshot(FUNC& func, IE& ie)
 {
 	if constexpr (std::is_base_of_v<with_snapshot, IE>)
 	{
-		func(SNAPSHOT{snapshot_id<IE>, sl::ie_length<type_context<typename IE::ie_type>>(ie, func)});
+		return func(SNAPSHOT{snapshot_id<IE>, sl::ie_length<type_context<typename IE::ie_type>>(ie, func), snapshot_hash<IE>});
+	}
+	else
+	{
+		MED_RETURN_SUCCESS;
 	}
 }
 
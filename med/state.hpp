@@ -12,6 +12,8 @@ Distributed under the MIT License
 #include <cstddef>
 #include <cstdint>
 
+#include "hash.hpp"
+
 namespace med {
 
 //Memorize the current state of buffer if not at the end (one entry in buffer itself).
@@ -29,6 +31,11 @@ struct ADVANCE_STATE
 {
 	int     delta;
 };
+//Skip the number of codec units ahead w/o decoding them (see select)
+struct SKIP_STATE
+{
+	std::size_t size; //in codec units
+};
 
 //Get length of IE in codec units
 struct GET_LENGTH {};
@@ -39,6 +46,14 @@ struct PUSH_SIZE
 	bool        commit{true}; //commit the size or delay
 };
 
+//Check the space for the run of IEs coded then w/o checks (see UNCHECKED).
+struct CHECK_SIZE
+{
+	std::size_t size; //in codec units
+};
+//Code IE w/o checking the space checked for its run already.
+struct UNCHECKED {};
+
 //Pad buffer with specfied number of bits using filler value.
 struct ADD_PADDING
 {
@@ -56,9 +71,13 @@ struct SNAPSHOT
 
 	id_type      id;
 	std::size_t  size;
+	std::size_t  hash; //of id to locate the snapshot in constant time
 };
 
 template <class IE>
 constexpr SNAPSHOT::id_type snapshot_id = IE::name();
 
+template <class IE>
+constexpr std::size_t snapshot_hash = hash<std::size_t>::compute(IE::name());
+
 }	//end: namespace med
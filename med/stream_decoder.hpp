@@ -0,0 +1,128 @@
+/**
+@file
+resumable decoding of a message arriving in parts
+
+@copyright Denis Priyomov 2016-2017
+Distributed under the MIT License
+(See accompanying file LICENSE or visit https://github.com/cppden/med)
+*/
+
+#pragma once
+
+#include "decoder_context.hpp"
+#include "octet_decoder.hpp"
+#include "sequence.hpp"
+
+namespace med {
+
+/**
+ * Decodes a sequence arriving in parts (e.g. segments of TCP stream).
+ * The parts are expected to be received contiguously into the same memory
+ * so no reassembly copy is made: only the end of data is moved by append().
+ * When data is not enough the decoding stops reporting how many more octets
+ * are needed at least and is resumed from the last top-level IE decoded
+ * completely so these IEs are not parsed again.
+ * NOTE: optional IEs at the end of the sequence are decoded as soon as the
+ *       data before them is complete, so the message needs own framing (e.g.
+ *       length in a header) to tell the end of message from the end of data.
+ */
+template <class DEC_CTX = decoder_context<>>
+class stream_decoder
+{
+public:
+	using state_type = typename DEC_CTX::buffer_type::state_type;
+
+	explicit stream_decoder(DEC_CTX& ctx) noexcept : m_ctx{ctx} {}
+
+	DEC_CTX& get_context() noexcept                { return m_ctx; }
+
+	//starts new message with the data received so far
+	void reset(void const* p, std::size_t size) noexcept
+	{
+		m_ctx.reset(p, size);
+		m_state = m_ctx.buffer().get_state();
+		m_index = 0;
+		m_need = 0;
+	}
+	template <typename T, std::size_t SIZE>
+	void reset(T const (&p)[SIZE]) noexcept        { reset(p, sizeof(p)); }
+
+	//more data received right after the data passed before
+	void append(std::size_t size) noexcept
+	{
+		auto& buf = m_ctx.buffer();
+		buf.end(buf.end() + size);
+		m_need = (m_need > size) ? m_need - size : 0;
+	}
+
+	//minimum number of octets to receive before decoding can progress
+	std::size_t need() const noexcept              { return m_need; }
+	//number of octets occupied by top-level IEs decoded completely
+	std::size_t offset() const noexcept            { return m_state - m_ctx.buffer().get_start(); }
+
+	/**
+	 * Decodes the message from the last resume point
+	 * @param msg message to decode into, must be the same between calls
+	 * @return true if message is decoded completely, false if more data is needed
+	 * NOTE: w/o exceptions false is also returned on error (see get_error_ctx)
+	 */
+	template <template <class> class DECODER = octet_decoder, class MSG>
+	bool decode(MSG& msg)
+	{
+		static_assert(std::is_same_v<IE_SEQUENCE, typename MSG::ie_type>, "SEQUENCE IS EXPECTED");
+
+		if (m_need) { return false; } //no chance to progress
+		auto& buf = m_ctx.buffer();
+		buf.set_state(m_state);
+		DECODER<DEC_CTX> decoder{m_ctx};
+#ifdef MED_NO_EXCEPTION
+		if (msg.decode_resume(decoder, *this)) { return true; }
+		auto& err = buf.error_ctx();
+		if (err.get_error() == error::overflow && partial(err.offset(), err.value(0))) { err.reset(); }
+		return false;
+#else
+		try
+		{
+			msg.decode_resume(decoder, *this);
+			return true;
+		}
+		catch (overflow const& ex)
+		{
+			if (not partial(ex.offset(), ex.bytes())) { throw; }
+			return false;
+		}
+#endif
+	}
+
+	//resume point maintained by sequence decoder
+	constexpr std::size_t index() const noexcept   { return m_index; }
+	constexpr void checkpoint(std::size_t index, state_type st) noexcept
+	{
+		m_index = index;
+		m_state = st;
+	}
+
+private:
+	stream_decoder(stream_decoder const&) = delete;
+	stream_decoder& operator=(stream_decoder const&) = delete;
+
+	//overflow beyond the data received means the rest of message is yet to come
+	bool partial(std::size_t ofs, std::size_t bytes) noexcept
+	{
+		auto& buf = m_ctx.buffer();
+		std::size_t const received = buf.end() - buf.get_start();
+		if (ofs + bytes > received)
+		{
+			m_need = ofs + bytes - received;
+			return true;
+		}
+		return false;
+	}
+
+	DEC_CTX&    m_ctx;
+	state_type  m_state{};
+	std::size_t m_index{0};
+	std::size_t m_need{0};
+};
+
+} //namespace med
@@ -0,0 +1,271 @@
+/**
+@file
+compile-time dispatch by tag to IE of set or choice
+
+@copyright Denis Priyomov 2016-2017
+Distributed under the MIT License
+(See accompanying file LICENSE or visit https://github.com/cppden/med)
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+
+#include "traits.hpp"
+#include "meta/typelist.hpp"
+#include "meta/foreach.hpp"
+
+namespace med {
+
+namespace detail {
+
+//tag with the value known at compile-time
+template <class T>
+concept AFixedTag = requires { typename std::integral_constant<uint64_t, uint64_t(T::get_encoded())>; };
+
+template <class CODEC>
+struct tag_of
+{
+	template <class IE>
+	using type = get_info_t<meta::list_first_t<meta::produce_info_t<CODEC, IE>>>;
+
+	struct is_fixed
+	{
+		template <class IE>
+		static constexpr bool value = AFixedTag<type<IE>>;
+	};
+	struct is_not_fixed
+	{
+		template <class IE>
+		static constexpr bool value = !AFixedTag<type<IE>>;
+	};
+};
+
+//not constexpr to fail compilation when reached
+void no_perfect_hash_for_tags();
+
+template <std::size_t N>
+using tag_index_t = conditional_t<(N < 0xFF), uint8_t, uint16_t>;
+
+//direct table for tags of close values
+template <std::size_t N, uint64_t MIN, std::size_t SPAN>
+struct dense_lookup
+{
+	using index_t = tag_index_t<N>;
+
+	explicit constexpr dense_lookup(std::array<uint64_t, N> const& tags)
+	{
+		for (auto& i : m_index) { i = N; }
+		for (std::size_t i = 0; i < N; ++i) { m_index[tags[i] - MIN] = index_t(i); }
+	}
+
+	constexpr std::size_t operator()(uint64_t tag) const
+	{
+		auto const i = tag - MIN; //wraps around if less than MIN
+		return i < SPAN ? m_index[i] : N;
+	}
+
+	index_t m_index[SPAN]{};
+};
+
+/**
+ * Perfect hash for sparse tags (hash and displace):
+ * tags are spread into buckets by primary hash then each bucket gets a seed
+ * which places all its tags into free slots by secondary hash.
+ */
+template <std::size_t N>
+struct hash_lookup
+{
+	using index_t = tag_index_t<N>;
+	using seed_t = uint16_t;
+	static constexpr std::size_t BUCKETS = std::bit_ceil(N) / 2;
+	static constexpr std::size_t SLOTS = std::bit_ceil(N) * 2;
+
+	static constexpr uint64_t hash(uint64_t v, uint64_t seed)
+	{
+		v ^= (seed + 1) * 0x9E3779B97F4A7C15ull;
+		v ^= v >> 32;
+		v *= 0xD6E8FEB86659FD93ull;
+		v ^= v >> 32;
+		return v;
+	}
+
+	explicit constexpr hash_lookup(std::array<uint64_t, N> const& tags) : m_tags{tags}
+	{
+		std::size_t bucket_size[BUCKETS]{};
+		std::size_t max_size = 0;
+		for (auto const tag : tags)
+		{
+			auto const n = ++bucket_size[hash(tag, 0) & (BUCKETS - 1)];
+			if (n > max_size) { max_size = n; }
+		}
+		for (auto& i : m_slot) { i = N; }
+
+		//larger buckets are placed first while there are more free slots
+		for (std::size_t size = max_size; size > 0; --size)
+		{
+			for (std::size_t b = 0; b < BUCKETS; ++b)
+			{
+				if (bucket_size[b] == size) { place(b); }
+			}
+		}
+	}
+
+	constexpr std::size_t operator()(uint64_t tag) const
+	{
+		auto const i = m_slot[hash(tag, m_seed[hash(tag, 0) & (BUCKETS - 1)]) & (SLOTS - 1)];
+		return (i < N && m_tags[i] == tag) ? i : N;
+	}
+
+private:
+	constexpr void place(std::size_t bucket)
+	{
+		for (seed_t seed = 1; seed != 0; ++seed)
+		{
+			std::size_t taken[N]{};
+			std::size_t num = 0;
+			bool fits = true;
+			for (std::size_t i = 0; fits && i < N; ++i)
+			{
+				if ((hash(m_tags[i], 0) & (BUCKETS - 1)) != bucket) { continue; }
+				auto const slot = hash(m_tags[i], seed) & (SLOTS - 1);
+				fits = (m_slot[slot] == N);
+				for (std::size_t j = 0; fits && j < num; ++j) { fits = (taken[j] != slot); }
+				taken[num++] = slot;
+			}
+			if (fits)
+			{
+				m_seed[bucket] = seed;
+				num = 0;
+				for (std::size_t i = 0; i < N; ++i)
+				{
+					if ((hash(m_tags[i], 0) & (BUCKETS - 1)) == bucket) { m_slot[taken[num++]] = index_t(i); }
+				}
+				return;
+			}
+		}
+		no_perfect_hash_for_tags();
+	}
+
+	std::array<uint64_t, N> m_tags;
+	seed_t  m_seed[BUCKETS]{};
+	index_t m_slot[SLOTS]{};
+};
+
+struct no_lookup
+{
+	constexpr std::size_t operator()(uint64_t) const   { return 0; }
+};
+
+template <std::size_t N>
+constexpr std::pair<uint64_t, uint64_t> tag_range(std::array<uint64_t, N> const& tags)
+{
+	auto lo = tags[0], hi = tags[0];
+	for (auto const tag : tags)
+	{
+		if (tag < lo) { lo = tag; }
+		if (tag > hi) { hi = tag; }
+	}
+	return {lo, hi};
+}
+
+template <std::size_t N>
+constexpr bool unique_tags(std::array<uint64_t, N> const& tags)
+{
+	for (std::size_t i = 0; i < N; ++i)
+	{
+		for (std::size_t j = i + 1; j < N; ++j)
+		{
+			if (tags[i] == tags[j]) { return false; }
+		}
+	}
+	return true;
+}
+
+template <auto TAGS>
+constexpr auto make_tag_lookup()
+{
+	constexpr std::size_t N = TAGS.size();
+	//otherwise the direct table silently keeps the last one only
+	static_assert(unique_tags(TAGS), "DUPLICATE TAGS");
+	if constexpr (N == 0)
+	{
+		return no_lookup{};
+	}
+	//direct table is affordable up to few times of the hashed one
+	else if constexpr (constexpr auto range = tag_range(TAGS); range.second - range.first < std::max<uint64_t>(256, 4 * N))
+	{
+		return dense_lookup<N, range.first, std::size_t(range.second - range.first + 1)>{TAGS};
+	}
+	else
+	{
+		return hash_lookup<N>{TAGS};
+	}
+}
+
+template <class CODEC, class FIXED, class OTHER>
+struct tag_dispatch;
+
+template <class CODEC, template<class...> class L, class... FIXED, class OTHER>
+struct tag_dispatch<CODEC, L<FIXED...>, OTHER>
+{
+	template <class IE>
+	using tag_t = typename tag_of<CODEC>::template type<IE>;
+
+	static constexpr std::array<uint64_t, sizeof...(FIXED)> tags{ uint64_t(tag_t<FIXED>::get_encoded())... };
+
+	template <class IE, class F, class... ARGS>
+	static constexpr auto invoke(F& f, ARGS&... args)    { return f.template apply<IE>(args...); }
+
+	//jump table of handlers for IEs with fixed tags
+	template <class F, class... ARGS>
+	using handler_t = decltype(std::declval<F&>().apply(std::declval<ARGS&>()...)) (*)(F&, ARGS&...);
+	template <class F, class... ARGS>
+	static constexpr handler_t<F, ARGS...> handlers[] = { &invoke<FIXED, F, ARGS...>... };
+
+	template <class F, class... ARGS>
+	static constexpr auto exec(uint64_t tag, F&& f, ARGS&&... args)
+	{
+		if constexpr (sizeof...(FIXED) > 0)
+		{
+			if (auto const i = lookup(tag); i < sizeof...(FIXED))
+			{
+				CODEC_TRACE("dispatch tag=%#zX to #%zu", std::size_t(tag), i);
+				return handlers<std::remove_reference_t<F>, std::remove_reference_t<ARGS>...>[i](f, args...);
+			}
+		}
+		return meta::for_if<OTHER>(f, args...);
+	}
+
+private:
+	static constexpr auto lookup = make_tag_lookup<tags>();
+};
+
+} //end: namespace detail
+
+/**
+ * Dispatches to IE of the list by its tag the same way as meta::for_if but
+ * in constant time for fixed tags which are looked up by the table built at
+ * compile-time. To keep the order of declaration only the fixed tags before
+ * the 1st other one (e.g. tag with match predicate) are in the table while
+ * the rest of IEs are checked one by one after that.
+ * @tparam CODEC codec to produce the meta-info with tag of each IE
+ * @tparam L list of IEs
+ * @param tag tag value decoded
+ * @param f functor with check/apply as for meta::for_if
+ */
+template <class CODEC, class L, class F, class... ARGS>
+constexpr auto tag_dispatch(uint64_t tag, F&& f, ARGS&&... args)
+{
+	using tag_of = detail::tag_of<std::remove_reference_t<CODEC>>;
+	using fixed = meta::list_before_t<L, typename tag_of::is_not_fixed>;
+	using other = meta::list_from_t<L, typename tag_of::is_not_fixed>;
+	return detail::tag_dispatch<std::remove_reference_t<CODEC>, fixed, other>::exec(tag, std::forward<F>(f), std::forward<ARGS>(args)...);
+}
+
+}	//end: namespace med
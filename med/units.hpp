@@ -32,7 +32,15 @@ template <std::size_t N> struct min {};
 template <std::size_t N> struct max : std::integral_constant<std::size_t, N> {};
 
 template <std::size_t N> struct arity : std::integral_constant<std::size_t, N> {};
-template <std::size_t N> struct pmax : std::integral_constant<std::size_t, N> {};
+
+//storage of multi-field instances allocated beyond inplace ones
+struct linked {};     //node per instance at stable address (default)
+struct contiguous {}; //single block relocated on growth w/ indexed access
+
+template <std::size_t N, class STORAGE = linked> struct pmax : std::integral_constant<std::size_t, N> {};
 using inf = pmax< std::numeric_limits<std::size_t>::max() >;
+//opt-in of contiguous storage for relocatable fields (e.g. values)
+template <std::size_t N> using vmax = pmax<N, contiguous>;
+using vinf = vmax< std::numeric_limits<std::size_t>::max() >;
 
 } //namespace med
@@ -18,12 +18,12 @@ Distributed under the MIT License
 namespace med {
 
 template <class FUNC, AHasIeType IE>
-constexpr void update(FUNC&& func, IE const& ie)
+constexpr MED_RESULT update(FUNC&& func, IE const& ie)
 {
 	static_assert(std::is_base_of<with_snapshot, IE>(), "IE WITH med::with_snapshot IS EXPECTED");
 	CODEC_TRACE("update %s", name<IE>());
-	func(SET_STATE{}, ie);
-	encode(func, ie);
+	MED_CHECK_FAIL(func(SET_STATE{}, ie));
+	return encode(func, ie);
 }
 
 }	//end: namespace med
@@ -12,6 +12,7 @@ Distributed under the MIT License
 #include <type_traits>
 
 #include "units.hpp"
+#include "value_traits.hpp"
 #include "ie_type.hpp"
 #include "name.hpp"
 #include "exception.hpp"
@@ -87,6 +88,39 @@ private:
 	value_type m_value{};
 };
 
+/**
+ * plain numeric value w/o presence flag (see packed)
+ * always set alone while its presence in container is kept by the container
+ */
+template <class TRAITS>
+struct packed_value : IE<IE_VALUE>
+{
+	using traits     = TRAITS;
+	using value_type = typename traits::value_type;
+	using base_t     = packed_value;
+
+	value_type get() const noexcept                 { return get_encoded(); }
+	auto set(value_type v) noexcept                 { return set_encoded(v); }
+
+	//NOTE: do not override!
+	static constexpr bool is_defined = false;
+	value_type get_encoded() const noexcept         { return m_value; }
+	void set_encoded(value_type v) noexcept         { m_value = v; }
+	static constexpr void clear() noexcept          { }
+	static constexpr bool is_set() noexcept         { return true; }
+	explicit operator bool() const noexcept         { return is_set(); }
+	template <class... ARGS>
+	void copy(base_t const& from, ARGS&&...)noexcept{ m_value = from.m_value; }
+
+	bool operator==(packed_value const& rhs) const noexcept { return get_encoded() == rhs.get_encoded(); }
+
+private:
+	value_type m_value{};
+};
+
+template <class TRAITS>
+using numeric_value_t = conditional_t<std::is_base_of_v<packed, TRAITS>, packed_value<TRAITS>, numeric_value<TRAITS>>;
+
 /**
  * plain fixed integral value
  * gives error if decoded value doesn't match the fixed one
@@ -196,14 +230,14 @@ struct value<T> : detail::value_selector<T>::type {};
 
 template<Arithmetic T, class... EXT_TRAITS>
 struct value<T, EXT_TRAITS...>
-		: detail::numeric_value<value_traits<T, EXT_TRAITS...>> {};
+		: detail::numeric_value_t<value_traits<T, EXT_TRAITS...>> {};
 
 template<std::size_t N, class... EXT_TRAITS>
 struct value<bytes<N>, EXT_TRAITS...>
-		: detail::numeric_value<value_traits<bytes<N>, EXT_TRAITS...>> {};
+		: detail::numeric_value_t<value_traits<bytes<N>, EXT_TRAITS...>> {};
 
 template<std::size_t N, std::size_t OFS, class... EXT_TRAITS>
 struct value<bits<N, OFS>, EXT_TRAITS...>
-		: detail::numeric_value<value_traits<bits<N, OFS>, EXT_TRAITS...>> {};
+		: detail::numeric_value_t<value_traits<bits<N, OFS>, EXT_TRAITS...>> {};
 
 } //namespace med
@@ -95,6 +95,13 @@ struct bits_infer<BITS>
 
 } //end: namespace detail
 
+/**
+ * Extension trait of value to store it w/o presence flag (see value): inside
+ * sequence or set its presence is kept by the container in one bitmap for all
+ * such values so many small optional fields are laid densely
+ */
+struct packed {};
+
 /******************************************************************************
 * Class:		value_traits
 * Description:	select min integer type to fit BITS bits
@@ -0,0 +1,70 @@
+/**
+@file
+direct access to fields of fixed layout in encoded message
+
+@copyright Denis Priyomov 2016-2017
+Distributed under the MIT License
+(See accompanying file LICENSE or visit https://github.com/cppden/med)
+*/
+
+#pragma once
+
+#include <span>
+
+#include "layout.hpp"
+
+namespace med {
+
+/**
+ * View of encoded message to read and rewrite in place the fields of fixed
+ * layout (see fixed_layout) by direct loads and stores at the offsets known
+ * at compile-time. The size is checked once on construction and nothing is
+ * decoded so it suits the hottest paths, e.g. to patch a header in proxy.
+ * NOTE: the values are read and written as encoded (see get_encoded)
+ * @tparam MSG sequence with the leading fields of fixed layout
+ * @tparam T octet type, const for read-only view
+ */
+template <class MSG, class T = uint8_t> requires std::is_same_v<uint8_t, std::remove_const_t<T>>
+class view
+{
+public:
+	using layout = fixed_layout<MSG>;
+	using pointer = T*;
+
+	constexpr view() noexcept = default;
+	//empty view if not enough data
+	constexpr explicit view(pointer p, std::size_t size) noexcept
+		: m_data{size < layout::size ? nullptr : p}
+	{}
+	template <class U, std::size_t N>
+	constexpr explicit view(std::span<U, N> s) noexcept
+		: view{s.data(), s.size_bytes()}
+	{}
+	template <class U, std::size_t N>
+	constexpr explicit view(U (&p)[N]) noexcept
+		: view{p, N}
+	{}
+
+	explicit constexpr operator bool() const noexcept   { return nullptr != m_data; }
+	constexpr pointer data() const noexcept             { return m_data; }
+	static constexpr std::size_t size() noexcept        { return layout::size; }
+
+	template <class FIELD> requires (layout::template has<FIELD>)
+	typename FIELD::value_type get() const
+	{
+		return load_bytes<layout::template width<FIELD>, typename FIELD::value_type>(at<FIELD>());
+	}
+
+	template <class FIELD> requires (layout::template has<FIELD> && !std::is_const_v<T>)
+	void set(typename FIELD::value_type v) const
+	{
+		store_bytes<layout::template width<FIELD>>(v, at<FIELD>());
+	}
+
+private:
+	template <class FIELD>
+	constexpr pointer at() const noexcept          { return m_data + layout::template offset<FIELD>; }
+
+	pointer m_data{nullptr};
+};
+}	//end: namespace med
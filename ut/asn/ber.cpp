@@ -7,6 +7,7 @@
 #include "asn/ber/ber_length.hpp"
 #include "asn/ber/ber_encoder.hpp"
 #include "asn/ber/ber_decoder.hpp"
+#include "reverse_buffer.hpp"
 
 using namespace std::literals;
 
@@ -270,6 +271,19 @@ TEST(asn_ber, tag)
 	static_assert(tv32bit::value == 0b00011111'10001111'11111111'11111111'11111111'01111111);
 }
 
+using reverse_context = med::encoder_context<med::null_allocator const, med::reverse_buffer<>>;
+
+//back-to-front encoding gives the same output
+template <class IE>
+void expect_reverse(IE const& ie, med::encoder_context<> const& ectx)
+{
+	static uint8_t rev_buf[128*1024];
+	reverse_context rctx{ rev_buf };
+	encode(med::asn::ber::encoder{rctx}, ie);
+	ASSERT_EQ(ectx.buffer().get_offset(), rctx.buffer().get_offset());
+	EXPECT_TRUE(Matches(ectx.buffer().get_start(), rctx.buffer().get_start(), rctx.buffer().get_offset()));
+}
+
 template <class IE> requires med::Arithmetic<typename IE::value_type>
 char const* encoded(typename IE::value_type const& val)
 {
@@ -279,6 +293,7 @@ char const* encoded(typename IE::value_type const& val)
 	IE enc;
 	enc.set(val);
 	encode(med::asn::ber::encoder{ectx}, enc);
+	expect_reverse(enc, ectx);
 
 	IE dec;
 	med::decoder_context<> dctx;
@@ -298,6 +313,7 @@ char const* encoded(T const* pval, std::size_t size)
 	IE enc;
 	enc.set(size, pval);
 	encode(med::asn::ber::encoder{ectx}, enc);
+	expect_reverse(enc, ectx);
 
 	IE dec;
 	med::decoder_context<> dctx;
@@ -316,6 +332,7 @@ char const* encoded(IE const& enc)
 	med::encoder_context<> ectx{ enc_buf };
 
 	encode(med::asn::ber::encoder{ectx}, enc);
+	expect_reverse(enc, ectx);
 
 	IE dec;
 	med::decoder_context<> dctx;
@@ -335,6 +352,7 @@ char const* encoded()
 
 	IE enc;
 	encode(med::asn::ber::encoder{ectx}, enc);
+	expect_reverse(enc, ectx);
 
 	IE dec;
 	med::decoder_context<> dctx;
@@ -645,6 +663,39 @@ TEST(asn_ber, sequence)
 
 	//?TODO: sequence with prefixed IEs, can starting prefixes collide?
 }
+
+TEST(asn_ber, sequence_reverse)
+{
+	//nested length in long form is known when encoded back-to-front
+	ab::Seq s;
+	uint8_t moct_val[200];
+	for (std::size_t i = 0; i < sizeof(moct_val); ++i) { moct_val[i] = uint8_t(i); }
+	s.ref<ab::moct>().set(sizeof(moct_val), moct_val);
+	s.ref<ab::mint>().set(7);
+
+	uint8_t buffer[256];
+	reverse_context ctx{ buffer };
+	encode(med::asn::ber::encoder{ctx}, s);
+
+	uint8_t const prefix[] = {0x30, 0x81, 0xCE, 0x80, 0x81, 0xC8};
+	ASSERT_EQ(sizeof(prefix) + sizeof(moct_val) + 3, ctx.buffer().get_offset());
+	auto const* out = ctx.buffer().get_start();
+	EXPECT_TRUE(Matches(prefix, out));
+	EXPECT_TRUE(Matches(moct_val, out + sizeof(prefix)));
+	uint8_t const suffix[] = {0x82, 0x01, 0x07};
+	EXPECT_TRUE(Matches(suffix, out + sizeof(prefix) + sizeof(moct_val)));
+
+	ab::Seq d;
+	med::decoder_context<> dctx{ ctx.buffer().used() };
+	decode(med::asn::ber::decoder{dctx}, d);
+	EXPECT_EQ(sizeof(moct_val), d.get<ab::moct>().size());
+	EXPECT_EQ(7, d.get<ab::mint>().get());
+
+	//not enough space
+	uint8_t small[100];
+	ctx.reset(small, sizeof(small));
+	EXPECT_THROW(encode(med::asn::ber::encoder{ctx}, s), med::overflow);
+}
 #endif
 
 //8.10 Encoding of a sequence-of value
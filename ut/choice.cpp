@@ -124,6 +124,20 @@ struct plain : med::choice<
 
 using PLAIN = M<L, plain>;
 
+struct LOW_TAG : med::value<uint8_t>
+{
+	static constexpr char const* name()       { return "LOW"; }
+	static constexpr bool match(value_type v) { return v < 0x10; }
+};
+
+//predicate tag before the fixed one it overlaps
+struct ordered : med::choice<
+	M< C<0x20>, L, U8  >,
+	M< LOW_TAG, L, U32 >,
+	M< C<0x02>, L, U16 >
+>
+{};
+
 } //end: namespace cho
 
 using namespace std::string_view_literals;
@@ -167,6 +181,25 @@ TEST(choice, plain)
 //	EXPECT_FALSE(pf->is_set());
 }
 
+TEST(choice, ordered)
+{
+	//the 1st IE matching in the order of declaration
+	uint8_t const low[] = {0x02, 4, 1, 2, 3, 4};
+	med::decoder_context<> ctx{low};
+	ordered msg;
+	decode(med::octet_decoder{ctx}, msg);
+	ASSERT_NE(nullptr, msg.get<U32>());
+	EXPECT_EQ(0x01020304, msg.get<U32>()->get());
+	EXPECT_EQ(nullptr, msg.get<U16>());
+
+	uint8_t const fixed[] = {0x20, 1, 7};
+	ctx.reset(fixed, sizeof(fixed));
+	msg.clear();
+	decode(med::octet_decoder{ctx}, msg);
+	ASSERT_NE(nullptr, msg.get<U8>());
+	EXPECT_EQ(7, msg.get<U8>()->get());
+}
+
 TEST(choice, any)
 {
 	uint8_t encoded[] = {6, 3, 4, 5,6,7,8};
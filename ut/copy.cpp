@@ -52,6 +52,13 @@ struct seq_r : med::sequence<
 	M< med::counter_t<byte>, word, med::min<2>, med::inf >
 >{};
 
+struct fwd : med::sequence<
+	M< T<0xF1>, byte, med::min<2>, med::inf >,
+	M< med::counter_t<byte>, dword, med::inf >,
+	O< T<0xF3>, L, hdr, med::inf >,
+	O< T<0xF4>, L, var_extern >
+>{};
+
 } //end: namespace cp
 
 TEST(copy, seq_same)
@@ -133,6 +140,44 @@ TEST(copy, seq_diff)
 	}
 }
 
+TEST(copy, seq_move)
+{
+	uint8_t const encoded[] = {
+		0xF1, 0x13, 0xF1, 0x37, 0xF1, 0x55, //TV*3
+		2, 0xDE, 0xAD, 0xBE, 0xEF, 0xC0, 0x01, 0xCA, 0xFE, //CV*2
+		0xF3, 3, 1, 0x12, 0x34, 0xF3, 3, 2, 0x56, 0x78, //TLV(hdr)*2
+		0xF4, 2, 'a', 'b', //TLV(extern)
+	};
+
+	cp::fwd src;
+	uint8_t dec_buf[256];
+	med::allocator alloc{dec_buf};
+	med::decoder_context<med::allocator> ctx{ encoded, &alloc };
+	decode(med::octet_decoder{ctx}, src);
+
+	auto const* bytes = src.get<cp::byte>().last();
+	auto const* dwords = src.get<cp::dword>().last();
+	auto const* hdr2 = std::next(src.get<cp::hdr>().begin()).get();
+	auto const* str = src.get<cp::var_extern>()->data();
+
+	//no allocator is needed as the external instances are relinked
+	cp::fwd dst;
+	dst.move_from(src);
+	EXPECT_EQ(bytes, dst.get<cp::byte>().last());
+	EXPECT_EQ(dwords, dst.get<cp::dword>().last());
+	EXPECT_EQ(hdr2, std::next(dst.get<cp::hdr>().begin()).get());
+	EXPECT_EQ(str, dst.get<cp::var_extern>()->data());
+	EXPECT_EQ(0, src.get<cp::byte>().count());
+	EXPECT_EQ(0, src.get<cp::dword>().count());
+	EXPECT_EQ(0, src.get<cp::hdr>().count());
+
+	uint8_t buffer[128];
+	med::encoder_context<> ectx{ buffer };
+	encode(med::octet_encoder{ectx}, dst);
+	EXPECT_EQ(sizeof(encoded), ectx.buffer().get_offset());
+	EXPECT_TRUE(Matches(encoded, buffer));
+}
+
 TEST(copy, choice)
 {
 	cp::cho src;
@@ -1,4 +1,6 @@
 #include "ut.hpp"
+#include "framer.hpp"
+#include "view.hpp"
 
 namespace diameter {
 
@@ -366,6 +368,12 @@ TEST(diameter, encode)
 
 	EXPECT_EQ(sizeof(diameter::dpr), ctx.buffer().get_offset());
 	EXPECT_STREQ(as_string(diameter::dpr), as_string(ctx.buffer()));
+
+	//single-pass with lengths patched
+	ctx.reset();
+	encode(med::octet_encoder{ctx, med::patch_length}, base);
+	EXPECT_EQ(sizeof(diameter::dpr), ctx.buffer().get_offset());
+	EXPECT_STREQ(as_string(diameter::dpr), as_string(ctx.buffer()));
 }
 
 TEST(diameter, decode)
@@ -386,6 +394,81 @@ TEST(diameter, decode)
 	ASSERT_EQ(2, msg->get<diameter::disconnect_cause>().body().get());
 }
 
+TEST(diameter, framer)
+{
+	constexpr std::size_t N = sizeof(diameter::dpr);
+	uint8_t buffer[3 * N];
+	for (std::size_t i = 0; i < 3; ++i) { std::memcpy(buffer + i * N, diameter::dpr, N); }
+	buffer[N + 19] = 0x66; //2nd E2E-ID
+
+	med::decoder_context<> ctx;
+	med::framer<diameter::base> framer{ctx};
+	//last message is incomplete
+	framer.reset(buffer, 2 * N + 2);
+
+	std::size_t num = 0;
+	for (auto frame : framer)
+	{
+		EXPECT_EQ(buffer + num * N, frame.data());
+		EXPECT_EQ(N, frame.size());
+		diameter::base base;
+		framer.decode(base);
+		EXPECT_EQ(num ? 0x55555566 : 0x55555555, base.header().end_id());
+		ASSERT_NE(nullptr, base.get<diameter::DPR>());
+		++num;
+	}
+	EXPECT_EQ(2, num);
+	EXPECT_EQ(2 * N, framer.offset());
+	EXPECT_EQ(2, framer.need()); //rest of the length
+
+	framer.append(2);
+	EXPECT_TRUE(framer.next().empty());
+	EXPECT_EQ(N - 4, framer.need()); //rest of the message
+	framer.append(N - 4);
+	EXPECT_EQ(N, framer.next().size());
+	EXPECT_EQ(3 * N, framer.offset());
+
+	//length beyond max size is invalid even if the message is incomplete
+	med::framer<diameter::base> limited{ctx, N - 1};
+	limited.reset(buffer, 4);
+	EXPECT_THROW(limited.next(), med::invalid_value);
+	EXPECT_EQ(0, limited.need());
+	EXPECT_TRUE(framer.next().empty());
+	EXPECT_EQ(0, framer.need());
+
+	//unexpected version
+	buffer[0] = 2;
+	framer.reset(buffer);
+	EXPECT_THROW(framer.next(), med::unknown_tag);
+}
+
+TEST(diameter, view)
+{
+	uint8_t buffer[sizeof(diameter::dpr)];
+	std::memcpy(buffer, diameter::dpr, sizeof(buffer));
+
+	//header follows version and length
+	med::view<diameter::header> hdr{buffer + 4, sizeof(buffer) - 4};
+	ASSERT_TRUE(hdr);
+	static_assert(16 == hdr.size());
+	EXPECT_EQ(0x80, hdr.get<diameter::cmd_flags>());
+	EXPECT_EQ(282, hdr.get<diameter::cmd_code>());
+	EXPECT_EQ(0x22222222, hdr.get<diameter::hop_by_hop_id>());
+
+	//relay with new hop-by-hop
+	hdr.set<diameter::hop_by_hop_id>(0x12345678);
+	hdr.set<diameter::cmd_code>(0x010203);
+	med::decoder_context<> ctx{ buffer };
+	diameter::base base;
+	decode(med::octet_decoder{ctx}, base);
+	EXPECT_EQ(0x12345678, base.header().hop_id());
+	EXPECT_EQ(0x55555555, base.header().end_id());
+	EXPECT_EQ(0x010203, base.header().get<diameter::cmd_code>().get());
+
+	med::view<diameter::header, uint8_t const> short_hdr{diameter::dpr + 4, 15};
+	EXPECT_FALSE(short_hdr);
+}
+
 TEST(diameter, bad_padding)
 {
 	uint8_t const dpr[] = {
@@ -525,6 +608,13 @@ TEST(diameter, any_avp)
 
 	EXPECT_EQ(sizeof(dpa_enc), ectx.buffer().get_offset());
 	ASSERT_TRUE(Matches(dpa_enc, buffer));
+
+	//single-pass with lengths of grouped AVP patched
+	std::fill(std::begin(buffer), std::end(buffer), 0);
+	ectx.reset();
+	encode(med::octet_encoder{ectx, med::patch_length}, base);
+	EXPECT_EQ(sizeof(dpa_enc), ectx.buffer().get_offset());
+	ASSERT_TRUE(Matches(dpa_enc, buffer));
 }
 
 TEST(diameter, any_msg)
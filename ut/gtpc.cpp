@@ -1,4 +1,5 @@
 #include "ut.hpp"
+#include "batch.hpp"
 
 
 //GTPC-like header for testing
@@ -129,3 +130,44 @@ TEST(opt_defs, set)
 	ASSERT_STREQ("44 01 02 03 70 ", as_string(ctx.buffer()));
 	check_decode(header, ctx.buffer());
 }
+
+TEST(gtpu, extract)
+{
+	struct flags : med::value<uint8_t> {};
+	struct msg_type : med::value<uint8_t> {};
+	struct length : med::value<uint16_t> {};
+	struct teid : med::value<uint32_t> {};
+	struct sn : med::value<uint16_t> {};
+	struct header : med::sequence<
+		M< flags >,
+		M< msg_type >,
+		M< length >,
+		M< teid >,
+		O< T<1>, sn >
+	>{};
+	using layout = med::fixed_layout<header>;
+	static_assert(8 == layout::size);
+	static_assert(4 == layout::offset<teid>);
+	static_assert(!layout::has<sn>);
+
+	uint8_t const p1[] = {0x30, 0xFF, 0x00, 0x04, 0x11, 0x22, 0x33, 0x44, 1, 2, 3, 4};
+	uint8_t const p2[] = {0x30, 0xFF, 0x01, 0x00, 0xDE, 0xAD, 0xBE, 0xEF};
+	uint8_t const p3[] = {0x30, 0xFF, 0x00, 0x00, 0x01};
+	std::span<uint8_t const> packets[] = {p1, p2, p3, p1};
+
+	uint16_t lens[4];
+	uint32_t teids[4];
+	//3rd packet is too short
+	ASSERT_EQ(2, (med::extract<header, length, teid>(packets, lens, teids)));
+	EXPECT_EQ(4, lens[0]);
+	EXPECT_EQ(0x11223344, teids[0]);
+	EXPECT_EQ(0x100, lens[1]);
+	EXPECT_EQ(0xDEADBEEF, teids[1]);
+
+	//3 octets value
+	uint8_t const h[] = {0x40, 0x01, 0x02, 0x03, 0x00};
+	std::span<uint8_t const> hdrs[] = {h};
+	uint32_t sns[1];
+	ASSERT_EQ(1, (med::extract<gtpc::header, gtpc::sequence_number>(hdrs, sns)));
+	EXPECT_EQ(0x010203, sns[0]);
+}
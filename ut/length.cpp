@@ -586,3 +586,44 @@ TEST(length, setter_with_length)
 	ASSERT_STREQ(as_string(encoded), as_string(ctx.buffer()));
 	check_decode(msg, ctx.buffer());
 }
+
+TEST(length, patch)
+{
+	//single-pass encoding w/ lengths patched is the same as with calculated
+	auto check = [](auto const& msg)
+	{
+		uint8_t calc[64] = {};
+		med::encoder_context<> cctx{ calc };
+		encode(med::octet_encoder{cctx}, msg);
+
+		uint8_t patched[64] = {};
+		med::encoder_context<> pctx{ patched };
+		encode(med::octet_encoder{pctx, med::patch_length}, msg);
+
+		ASSERT_EQ(cctx.buffer().get_offset(), pctx.buffer().get_offset());
+		EXPECT_TRUE(Matches(calc, patched));
+	};
+
+	using namespace len;
+	{
+		s_nssai msg; //explicit length
+		msg.ref<sst>().set(2);
+		msg.ref<sd>().set(3);
+		msg.ref<mapped_sst>().set(4);
+		check(msg);
+	}
+	{
+		SLEN msg; //nested with setters
+		msg.ref<SFLD>().ref<U16>().set(0x55AA);
+		msg.ref<SMFLD>().ref<U8>().push_back()->set(1);
+		check(msg);
+	}
+	{
+		ppp::proto msg; //custom length
+		msg.header().ref<ppp::id>().set(3);
+		auto& c = msg.ref<ppp::challenge>();
+		uint8_t const cval[] = {1, 2};
+		c.ref<ppp::cval>().set(cval);
+		check(msg);
+	}
+}
@@ -2,6 +2,8 @@
 #include "ut_proto.hpp"
 
 #include "update.hpp"
+#include "batch.hpp"
+#include "iovec_buffer.hpp"
 
 static_assert (med::AAllocator<med::null_allocator>);
 
@@ -277,6 +279,95 @@ TEST(field, init)
 }
 #endif
 
+TEST(encode, batch)
+{
+	struct MSG : med::sequence< M<T<7>, L, FLD_U16> > {};
+	MSG msgs[5];
+	for (uint16_t i = 0; i < 5; ++i) { msgs[i].ref<FLD_U16>().set(0x100 + i); }
+
+	uint8_t buffer[3][10];
+	med::batch_entry entries[5];
+	med::encoder_context<> ctx{ buffer[0] };
+
+	//2nd message doesn't fit and is rolled back
+	ASSERT_EQ(2, med::encode_batch(med::octet_encoder{ctx}, msgs, entries));
+	EXPECT_EQ(8, ctx.buffer().get_offset());
+	uint8_t const encoded[] = {7, 2, 0x01,0x00, 7, 2, 0x01,0x01};
+	EXPECT_TRUE(Matches(encoded, buffer[0]));
+	EXPECT_EQ(4, entries[1].offset);
+	EXPECT_EQ(4, entries[1].size);
+
+	//continued after flush
+	ctx.reset();
+	ASSERT_EQ(2, med::encode_batch(med::octet_encoder{ctx}, std::span{msgs}.subspan(2), entries));
+	EXPECT_EQ(0x02, buffer[0][3]);
+	EXPECT_EQ(0x03, buffer[0][7]);
+
+	//chain of buffers
+	std::span<uint8_t> chain[] = {buffer[0], buffer[1], buffer[2]};
+	ASSERT_EQ(5, med::encode_batch(med::octet_encoder{ctx}, msgs, entries, chain));
+	EXPECT_EQ(2, entries[4].buffer);
+	EXPECT_EQ(0, entries[4].offset);
+	EXPECT_EQ(1, entries[3].buffer);
+	EXPECT_EQ(4, entries[3].offset);
+	EXPECT_EQ(0x04, buffer[2][3]);
+}
+
+TEST(encode, batch_iovec)
+{
+	struct HEAD : med::octet_string<med::octets_var_extern> {};
+	struct TAIL : med::octet_string<med::octets_var_extern> {};
+	struct MSG : med::sequence< M<T<1>, L, HEAD>, M<T<2>, L, TAIL> > {};
+	uint8_t data[150] = {};
+	MSG msgs[2];
+	for (auto& msg : msgs)
+	{
+		msg.ref<HEAD>().set(data);
+		msg.ref<TAIL>().set(data);
+	}
+
+	//2nd message runs out of segments after its head is referred
+	uint8_t buffer[16];
+	med::batch_entry entries[2];
+	med::encoder_context<const med::null_allocator, med::iovec_buffer<8>> ctx{ buffer };
+	ASSERT_EQ(1, med::encode_batch(med::octet_encoder{ctx}, msgs, entries));
+	EXPECT_EQ(4 + 2 * sizeof(data), ctx.buffer().total_size());
+	auto const iov = ctx.buffer().iov();
+	ASSERT_EQ(4, iov.size());
+	EXPECT_EQ(data, iov[3].iov_base);
+	EXPECT_EQ(2, iov[2].iov_len);
+}
+
+TEST(decode, batch)
+{
+	struct MSG : med::sequence< M<T<7>, L, FLD_U16>, O<T<8>, L, FLD_U8, med::max<4>> > {};
+	uint8_t const ok[] = {7, 2, 0x12, 0x34, 8, 1, 1, 8, 1, 2, 8, 1, 3};
+	uint8_t const short_len[] = {7, 2, 0x12};
+	uint8_t const bad_tag[] = {6, 2, 0x12, 0x34};
+	uint8_t const extra[] = {7, 2, 0x56, 0x78, 8, 1, 1, 8, 1, 2, 8, 1, 3, 8, 1, 4, 8, 1, 5};
+	std::span<uint8_t const> packets[] = {ok, short_len, bad_tag, extra, ok};
+
+	MSG msgs[5];
+	med::error status[5];
+	//instances beyond inplace share the allocator
+	uint8_t mem[256];
+	med::allocator alloc{mem};
+	med::decoder_context<med::allocator> ctx{nullptr, 0, &alloc};
+
+	for (int n = 0; n < 2; ++n) //messages are reused
+	{
+		EXPECT_EQ(2, med::decode_batch(med::octet_decoder{ctx}, packets, msgs, status));
+		EXPECT_EQ(med::error::success, status[0]);
+		EXPECT_EQ(med::error::overflow, status[1]);
+		EXPECT_EQ(med::error::unknown_tag, status[2]);
+		EXPECT_EQ(med::error::extra_ie, status[3]);
+		EXPECT_EQ(med::error::success, status[4]);
+		EXPECT_EQ(0x1234, msgs[4].get<FLD_U16>().get());
+		EXPECT_EQ(3, msgs[4].get<FLD_U8>().count());
+		alloc.release();
+	}
+}
+
 #if 1
 //update
 struct UFLD : med::value<uint32_t>, med::with_snapshot
@@ -330,6 +421,89 @@ TEST(update, unused)
 	ufld.set(0x3456789A);
 	EXPECT_THROW(update(encoder, ufld), med::missing_ie);
 }
+
+struct UFLD2 : med::value<uint16_t>, med::with_snapshot
+{
+	static constexpr auto name() { return "Updatable-Field-2"; }
+};
+struct UMSG2 : med::sequence< M<T<7>, L, UFLD>, M<UFLD2> > {};
+
+TEST(update, several)
+{
+	UMSG2 msg;
+	msg.ref<UFLD>().set(0x12345678);
+	msg.ref<UFLD2>().set(0x1234);
+
+	uint8_t buffer[16];
+	//no allocator is needed to keep snapshots
+	med::encoder_context<const med::null_allocator, med::buffer<uint8_t>, 2> ctx{ buffer };
+	med::octet_encoder encoder{ctx};
+
+	for (int i = 0; i < 2; ++i) //the same after reset
+	{
+		ctx.reset();
+		encode(encoder, msg);
+		uint8_t const encoded[] = {7, 4, 0x12,0x34,0x56,0x78, 0x12,0x34};
+		EXPECT_EQ(sizeof(encoded), ctx.buffer().get_offset());
+		EXPECT_TRUE(Matches(encoded, buffer));
+	}
+
+	msg.ref<UFLD2>().set(0xABCD);
+	update(encoder, msg.get<UFLD2>());
+	msg.ref<UFLD>().set(0x3456789A);
+	update(encoder, msg.get<UFLD>());
+
+	uint8_t const updated[] = {7, 4, 0x34,0x56,0x78,0x9A, 0xAB,0xCD};
+	EXPECT_TRUE(Matches(updated, buffer));
+
+	//no room for more snapshots than expected
+	med::encoder_context<const med::null_allocator, med::buffer<uint8_t>, 1> small{ buffer };
+	EXPECT_THROW(encode(med::octet_encoder{small}, msg), med::out_of_memory);
+
+	//the rest is allocated once the table is full
+	size_t albuf[16];
+	med::allocator alloc{albuf};
+	med::encoder_context<med::allocator, med::buffer<uint8_t>, 1> spill{ buffer, &alloc };
+	med::octet_encoder sencoder{spill};
+	encode(sencoder, msg);
+	EXPECT_NE(albuf, alloc.allocate(1, 1));
+	msg.ref<UFLD2>().set(0x5678);
+	update(sencoder, msg.get<UFLD2>());
+	msg.ref<UFLD>().set(0x12345678);
+	update(sencoder, msg.get<UFLD>());
+	uint8_t const spilled[] = {7, 4, 0x12,0x34,0x56,0x78, 0x56,0x78};
+	EXPECT_TRUE(Matches(spilled, buffer));
+}
+
+TEST(update, batch)
+{
+	struct MSG : med::sequence< M<T<7>, L, UFLD>, O<T<8>, UFLD2> > {};
+	MSG msgs[3];
+	for (uint16_t i = 0; i < 3; ++i) { msgs[i].ref<UFLD>().set(i); }
+	msgs[0].ref<UFLD2>().set(0x1234);
+
+	uint8_t buffer[16];
+	med::batch_entry entries[3];
+	med::encoder_context<const med::null_allocator, med::buffer<uint8_t>, 2> ctx{ buffer };
+	med::octet_encoder encoder{ctx};
+
+	//last one doesn't fit and is rolled back with its snapshots
+	ASSERT_EQ(2, med::encode_batch(encoder, msgs, entries));
+	EXPECT_EQ(15, ctx.buffer().get_offset());
+	EXPECT_THROW(update(encoder, msgs[1].get<UFLD>()), med::missing_ie);
+
+	//snapshots of the last message encoded only
+	ctx.reset();
+	ASSERT_EQ(2, med::encode_batch(encoder, std::span{msgs}.first(2), entries));
+	EXPECT_THROW(update(encoder, *msgs[0].get<UFLD2>()), med::missing_ie);
+	msgs[1].ref<UFLD>().set(0x3456789A);
+	update(encoder, msgs[1].get<UFLD>());
+	uint8_t const encoded[] = {
+		7, 4, 0,0,0,0, 8, 0x12,0x34,
+		7, 4, 0x34,0x56,0x78,0x9A,
+	};
+	EXPECT_TRUE(Matches(encoded, buffer));
+}
 #endif
 
 int main(int argc, char **argv)
@@ -2,6 +2,7 @@
 #include <optional>
 
 #include "meta/typelist.hpp"
+#include "tag_dispatch.hpp"
 
 
 TEST(meta, index)
@@ -86,3 +87,20 @@ TEST(meta, interleave)
 			med::meta::interleave_t<list1, float>
 		>);
 }
+
+TEST(meta, tag_lookup)
+{
+	//close tags are looked up directly
+	static constexpr std::array<uint64_t, 4> dense{ 0x21, 0x0b, 0x49, 0x89 };
+	constexpr auto dlookup = med::detail::make_tag_lookup<dense>();
+	static_assert(std::is_same_v<decltype(dlookup), med::detail::dense_lookup<4, 0x0b, 0x7F> const>);
+	static_assert(dlookup(0x0b) == 1 && dlookup(0x89) == 3);
+	static_assert(dlookup(0) == 4 && dlookup(0x0c) == 4 && dlookup(0x8A) == 4);
+
+	//sparse tags are perfectly hashed
+	static constexpr std::array<uint64_t, 6> sparse{ 1, 1000, 70000, 0x1000000, 0xDEADBEEF, 0xFFFFFFFF };
+	constexpr auto hlookup = med::detail::make_tag_lookup<sparse>();
+	static_assert(std::is_same_v<decltype(hlookup), med::detail::hash_lookup<6> const>);
+	static_assert(hlookup(1) == 0 && hlookup(70000) == 2 && hlookup(0xFFFFFFFF) == 5);
+	static_assert(hlookup(0) == 6 && hlookup(1001) == 6);
+}
@@ -1,4 +1,6 @@
 #include "ut.hpp"
+#include "arena_allocator.hpp"
+#include "bounds.hpp"
 
 namespace multi {
 
@@ -16,7 +18,19 @@ struct U32 : med::value<uint32_t> {};
 
 struct M1 : med::sequence<
 	M< T<1>, U8, med::max<3>>,
-	O< T<2>, U16, med::inf>
+	O< T<2>, U16, med::vinf>
+>{};
+
+struct SEQ : med::sequence<
+	M< U8 >
+>{};
+struct STR : med::octet_string<med::octets_var_intern<8>, med::min<0>> {};
+struct BOUNDED : med::sequence<
+	M< T<1>, U8, med::max<3> >,
+	O< T<2>, L, U16 >,
+	O< T<3>, L, STR >,
+	M< med::counter_t<U8>, SEQ, med::pmax<4> >,
+	M< med::counter_t<U8>, U32, med::vmax<5> >
 >{};
 
 } //end: namespace multi
@@ -91,6 +105,22 @@ TEST(multi, clear)
 	EXPECT_FALSE(mie.empty());
 	EXPECT_EQ(3, mie.count());
 	EXPECT_EQ(3, std::distance(mie.begin(), mie.end()));
+
+	//instances are cleared when reused rather than on reset
+	msg.clear();
+	EXPECT_TRUE(mie.empty());
+	auto* p = msg.ref<U8>().push_back();
+	ASSERT_NE(nullptr, p);
+	EXPECT_FALSE(p->is_set());
+
+	BOUNDED seqs;
+	seqs.ref<SEQ>().push_back()->ref<U8>().set(1);
+	seqs.clear();
+	EXPECT_TRUE(seqs.get<SEQ>().empty());
+	auto* ps = seqs.ref<SEQ>().push_back();
+	ASSERT_NE(nullptr, ps);
+	EXPECT_FALSE(ps->is_set());
+	EXPECT_THROW(seqs.ref<SEQ>().push_back(), med::out_of_memory); //single inplace slot
 }
 
 TEST(multi, erase)
@@ -141,3 +171,269 @@ TEST(multi, erase)
 	EXPECT_EQ(sizeof(encoded), ctx.buffer().get_offset());
 	EXPECT_TRUE(Matches(encoded, buffer));
 }
+
+TEST(multi, contiguous)
+{
+	alignas(8) uint8_t mem[64];
+	med::allocator alloc{mem};
+
+	using namespace multi;
+	M1 msg;
+	auto& mie = msg.ref<U16>();
+	static_assert(std::is_pointer_v<decltype(mie.begin())>, "CONTIGUOUS STORAGE EXPECTED");
+	static_assert(!std::is_pointer_v<decltype(msg.ref<U8>().begin())>, "LINKED STORAGE BY DEFAULT");
+
+	for (uint16_t i = 1; i <= 5; ++i)
+	{
+		auto* p = mie.push_back(alloc);
+		ASSERT_NE(nullptr, p);
+		p->set(i);
+	}
+	EXPECT_EQ(5, mie.count());
+	EXPECT_LE(5, mie.capacity());
+	EXPECT_EQ(mie.first() + 4, mie.last());
+	for (std::size_t i = 0; i < mie.count(); ++i)
+	{
+		EXPECT_EQ(i + 1, mie[i].get());
+	}
+
+	mie.erase(mie.begin() + 1); //(1,3,4,5)
+	mie.pop_back(); //(1,3,4)
+	ASSERT_EQ(3, mie.count());
+	EXPECT_EQ(1, mie[0].get());
+	EXPECT_EQ(3, mie[1].get());
+	EXPECT_EQ(4, mie[2].get());
+	EXPECT_FALSE(mie.data()[3].is_set());
+}
+
+TEST(multi, reserve_counted)
+{
+	using namespace multi;
+	struct SEQ : med::sequence<
+		M< U8 >
+	>{};
+	struct MSG : med::sequence<
+		M< med::counter_t<U8>, SEQ, med::inf >,
+		M< med::counter_t<U8>, U16, med::vinf >
+	>{};
+
+	uint8_t const encoded[] = {
+		3, 1, 2, 3,
+		5, 0,1, 0,2, 0,3, 0,4, 0,5,
+	};
+	//list takes nodes beyond inplace while vector moves all into the block
+	//so the room is exact to fail if allocated one by one
+	using seq_ie = med::mandatory<med::counter_t<U8>, SEQ, med::inf>;
+	using u16_ie = med::mandatory<med::counter_t<U8>, U16, med::vinf>;
+	alignas(8) uint8_t mem[2 * sizeof(seq_ie::field_value) + 5 * sizeof(u16_ie::field_value)];
+	med::allocator alloc{mem};
+	med::decoder_context<med::allocator> ctx{ encoded, &alloc };
+
+	MSG msg;
+	decode(med::octet_decoder{ctx}, msg);
+
+	auto const& seqs = msg.get<SEQ>();
+	ASSERT_EQ(3, seqs.count());
+	uint8_t v = 0;
+	for (auto const& s : seqs) { EXPECT_EQ(++v, s.get<U8>().get()); }
+
+	auto const& u16s = msg.get<U16>();
+	ASSERT_EQ(5, u16s.count());
+	for (std::size_t i = 0; i < u16s.count(); ++i) { EXPECT_EQ(i + 1, u16s[i].get()); }
+}
+
+TEST(multi, arena)
+{
+	//counts blocks taken from upstream (on stack to be in link range of message)
+	struct counting_resource : std::pmr::memory_resource
+	{
+		void* do_allocate(std::size_t bytes, std::size_t align) override
+		{
+			++allocated;
+			return pool.allocate(bytes, align);
+		}
+		void do_deallocate(void* p, std::size_t bytes, std::size_t align) override
+		{
+			++deallocated;
+			pool.deallocate(p, bytes, align);
+		}
+		bool do_is_equal(std::pmr::memory_resource const& rhs) const noexcept override { return this == &rhs; }
+
+		std::size_t allocated {0};
+		std::size_t deallocated {0};
+		alignas(8) uint8_t mem[8192];
+		std::pmr::monotonic_buffer_resource pool{mem, sizeof(mem), std::pmr::null_memory_resource()};
+	};
+
+	using namespace multi;
+	uint8_t encoded[2 + 64 * 3];
+	std::size_t len = 0;
+	encoded[len++] = 1; encoded[len++] = 7; //U8
+	for (uint8_t i = 0; i < 64; ++i)
+	{
+		encoded[len++] = 2; encoded[len++] = 0; encoded[len++] = i;
+	}
+
+	counting_resource upstream;
+	{
+		alignas(8) uint8_t mem[16];
+		med::arena_allocator alloc{mem, &upstream, 64};
+		med::decoder_context<med::arena_allocator> ctx{ encoded, &alloc };
+
+		std::size_t blocks = 0;
+		for (int n = 0; n < 2; ++n)
+		{
+			M1 msg;
+			decode(med::octet_decoder{ctx}, msg);
+			auto const& u16s = msg.get<U16>();
+			ASSERT_EQ(64, u16s.count());
+			EXPECT_EQ(63, u16s.last()->get());
+
+			//next message reuses the blocks
+			if (n == 0) { blocks = upstream.allocated; }
+			EXPECT_LT(0, blocks);
+			EXPECT_EQ(blocks, upstream.allocated);
+			EXPECT_LE(64 * sizeof(U16), alloc.chained());
+			alloc.release();
+			ctx.reset(encoded, len);
+		}
+		EXPECT_EQ(0, upstream.deallocated);
+
+		//w/o upstream it fails as plain allocator
+		med::arena_allocator fixed{mem, nullptr};
+		EXPECT_EQ(nullptr, fixed.allocate(sizeof(mem) + 1, 1));
+		EXPECT_EQ(blocks, upstream.allocated);
+	}
+	EXPECT_EQ(upstream.allocated, upstream.deallocated);
+}
+
+TEST(multi, bounds)
+{
+	using namespace multi;
+	using MSG = BOUNDED;
+	using seq_ie = med::mandatory<med::counter_t<U8>, SEQ, med::pmax<4>>;
+	using u32_ie = med::mandatory<med::counter_t<U8>, U32, med::vmax<5>>;
+	constexpr auto seq_node = sizeof(seq_ie::field_value) + alignof(seq_ie::field_value) - 1;
+	constexpr auto u32_block = sizeof(u32_ie::field_value) + alignof(u32_ie::field_value) - 1;
+	static_assert(3*2 + 4 + 10 + (1 + 4*1) + (1 + 5*4) == med::max_encoded_size<MSG>());
+	//list grows by node while vector by block of 2, 4 and then 5 instances
+	static_assert(3 * seq_node + (2 + 4 + 5) * sizeof(u32_ie::field_value) + 3 * (u32_block - sizeof(u32_ie::field_value))
+		== med::max_arena_bytes<MSG>());
+
+	alignas(8) uint8_t emem[med::max_arena_bytes<MSG>()];
+	med::allocator ealloc{emem};
+	MSG msg;
+	for (uint8_t i = 0; i < 3; ++i) { msg.ref<U8>().push_back()->set(i); }
+	msg.ref<U16>().set(0x1234);
+	msg.ref<STR>().set("12345678"sv);
+	for (uint8_t i = 0; i < 4; ++i) { msg.ref<SEQ>().push_back(ealloc)->ref<U8>().set(i); }
+	for (uint32_t i = 0; i < 5; ++i) { msg.ref<U32>().push_back(ealloc)->set(i); }
+
+	uint8_t buffer[med::max_encoded_size<MSG>()];
+	med::encoder_context<> ctx{ buffer };
+	encode(med::octet_encoder{ctx}, msg);
+	EXPECT_EQ(sizeof(buffer), ctx.buffer().get_offset());
+
+	alignas(8) uint8_t mem[med::max_arena_bytes<MSG>()];
+	med::allocator alloc{mem};
+	med::decoder_context<med::allocator> dctx{ ctx.buffer().used(), &alloc };
+	MSG dmsg;
+	decode(med::octet_decoder{dctx}, dmsg);
+	EXPECT_EQ(msg, dmsg);
+}
+
+TEST(multi, relocate)
+{
+	using namespace multi;
+	using MSG = BOUNDED;
+	static_assert(sizeof(med::link<SEQ>) == 4);
+
+	uint8_t const encoded[] = {
+		1, 0, 1, 1, 1, 2,
+		2, 2, 0x12, 0x34,
+		3, 3, 'a', 'b', 'c',
+		4, 0, 1, 2, 3,
+		5, 0,0,0,1, 0,0,0,2, 0,0,0,3, 0,0,0,4, 0,0,0,5,
+	};
+	//message and its instances allocated in the same blob
+	alignas(8) uint8_t blob[sizeof(MSG) + med::max_arena_bytes<MSG>()];
+	med::allocator alloc{blob};
+	auto* msg = med::create<MSG>(alloc);
+	med::decoder_context<med::allocator> ctx{ encoded, &alloc };
+	decode(med::octet_decoder{ctx}, *msg);
+	ASSERT_EQ(4, msg->get<SEQ>().count());
+
+	//copied as a whole the message refers to its own instances
+	alignas(8) uint8_t copy[sizeof(blob)];
+	std::memcpy(copy, blob, sizeof(blob));
+	std::memset(blob, 0, sizeof(blob));
+	auto const& moved = *reinterpret_cast<MSG const*>(copy);
+	uint8_t i = 0;
+	for (auto& seq : moved.get<SEQ>())
+	{
+		EXPECT_LT(uintptr_t(copy), uintptr_t(&seq));
+		EXPECT_GT(uintptr_t(copy + sizeof(copy)), uintptr_t(&seq));
+		EXPECT_EQ(i++, seq.get<U8>().get());
+	}
+
+	uint8_t buffer[sizeof(encoded)];
+	med::encoder_context<> ectx{ buffer };
+	encode(med::octet_encoder{ectx}, moved);
+	EXPECT_TRUE(Matches(encoded, buffer));
+
+	//allocation out of link range is unusable (static storage vs stack)
+	alignas(8) static uint8_t far_mem[med::max_arena_bytes<MSG>()];
+	med::allocator far_alloc{far_mem};
+	med::decoder_context<med::allocator> far_ctx{ encoded, &far_alloc };
+	MSG far_msg;
+	EXPECT_THROW(decode(med::octet_decoder{far_ctx}, far_msg), med::out_of_memory);
+}
+
+TEST(multi, validate)
+{
+	using namespace multi;
+	uint8_t encoded[2 * 4 + 64 * 3];
+	std::size_t len = 0;
+	for (uint8_t i = 0; i < 3; ++i) { encoded[len++] = 1; encoded[len++] = i; }
+	for (uint8_t i = 0; i < 64; ++i)
+	{
+		encoded[len++] = 2; encoded[len++] = 0; encoded[len++] = i;
+	}
+
+	//no allocator to decode the instances beyond inplace
+	med::decoder_context<> ctx{ encoded, len };
+	{
+		M1 msg;
+		EXPECT_THROW(decode(med::octet_decoder{ctx}, msg), med::out_of_memory);
+	}
+	ctx.reset(encoded, len);
+	EXPECT_NO_THROW(med::validate<M1>(med::octet_decoder{ctx}));
+	EXPECT_EQ(0, ctx.buffer().size());
+
+	//counted instances of containers
+	struct SEQ : med::sequence<
+		M< U8 >
+	>{};
+	struct MSG : med::sequence<
+		M< med::counter_t<U8>, SEQ, med::max<4> >
+	>{};
+	//decoded one by one w/o instances kept in the message
+	static_assert(sizeof(med::detail::shadow_t<MSG>) < sizeof(MSG));
+	uint8_t const seqs[] = {4, 1, 2, 3, 4};
+	ctx.reset(seqs, sizeof(seqs));
+	EXPECT_NO_THROW(med::validate<MSG>(med::octet_decoder{ctx}));
+	ctx.reset(seqs, sizeof(seqs) - 1);
+	EXPECT_THROW(med::validate<MSG>(med::octet_decoder{ctx}), med::overflow);
+	uint8_t const extra_seqs[] = {5, 1, 2, 3, 4, 5};
+	ctx.reset(extra_seqs, sizeof(extra_seqs));
+	EXPECT_THROW(med::validate<MSG>(med::octet_decoder{ctx}), med::extra_ie);
+
+	//1st violation is reported
+	ctx.reset(encoded, len - 1);
+	EXPECT_THROW(med::validate<M1>(med::octet_decoder{ctx}), med::overflow);
+	encoded[2 * 3] = 1; encoded[2 * 3 + 1] = 3; //4th T<1>
+	ctx.reset(encoded, 2 * 4);
+	EXPECT_THROW(med::validate<M1>(med::octet_decoder{ctx}), med::extra_ie);
+	ctx.reset(encoded + 2 * 3 + 2, 3);
+	EXPECT_THROW(med::validate<M1>(med::octet_decoder{ctx}), med::missing_ie);
+}
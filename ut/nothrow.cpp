@@ -0,0 +1,313 @@
+/*
+ * Built with MED_NO_EXCEPTION and -fno-exceptions: errors are reported
+ * via return value and error context of the buffer.
+ */
+#include "ut.hpp"
+#include "ut_proto.hpp"
+
+#include "asn/asn.hpp"
+#include "asn/ber/ber_encoder.hpp"
+#include "asn/ber/ber_decoder.hpp"
+#include "protobuf/protobuf.hpp"
+#include "protobuf/encoder.hpp"
+#include "protobuf/decoder.hpp"
+#include "stream_decoder.hpp"
+#include "framer.hpp"
+#include "cold.hpp"
+#include "bit_string.hpp"
+
+static_assert(std::is_same_v<bool, MED_RESULT>, "NO-EXCEPTION MODE EXPECTED");
+
+TEST(nothrow, decode_ok)
+{
+	uint8_t const encoded[] = { 0x01
+		, 37
+		, 0x21, 0x35, 0xD9
+		, 3, 0xDA, 0xBE, 0xEF
+		, 0x42, 4, 0xFE, 0xE1, 0xAB, 0xBA
+	};
+	med::decoder_context<> ctx{ encoded };
+	PROTO proto;
+
+	ASSERT_TRUE(decode(med::octet_decoder{ctx}, proto));
+	EXPECT_FALSE(med::get_error_ctx(ctx));
+	EXPECT_EQ(med::error::success, ctx.buffer().error_ctx().get_error());
+	auto const* msg = proto.get<MSG_SEQ>();
+	ASSERT_NE(nullptr, msg);
+	EXPECT_EQ(37, msg->get<FLD_UC>().get());
+}
+
+TEST(nothrow, decode_overflow)
+{
+	uint8_t const encoded[] = { 0x01, 37, 0x21 };
+	med::decoder_context<> ctx{ encoded };
+	PROTO proto;
+
+	ASSERT_FALSE(decode(med::octet_decoder{ctx}, proto));
+	auto const& err = med::get_error_ctx(ctx);
+	ASSERT_TRUE(err);
+	EXPECT_EQ(med::error::overflow, err.get_error());
+	EXPECT_STREQ("U16", err.name());
+	EXPECT_EQ(2, err.value(0));
+	EXPECT_EQ(3, err.offset());
+
+	char sz[128];
+	EXPECT_STREQ("'U16' needs 2 octets. @3", err.format(sz));
+
+	//reset of the context clears the error
+	ctx.reset(encoded, sizeof(encoded));
+	EXPECT_FALSE(med::get_error_ctx(ctx));
+}
+
+TEST(nothrow, decode_unknown_tag)
+{
+	uint8_t const encoded[] = { 0x55, 37 };
+	med::decoder_context<> ctx{ encoded };
+	PROTO proto;
+
+	ASSERT_FALSE(decode(med::octet_decoder{ctx}, proto));
+	auto const& err = med::get_error_ctx(ctx);
+	EXPECT_EQ(med::error::unknown_tag, err.get_error());
+	EXPECT_EQ(0x55, err.value(0));
+	EXPECT_EQ(1, err.offset());
+}
+
+TEST(nothrow, decode_invalid_value)
+{
+	//length of VFLD1 is less than min (5)
+	uint8_t const encoded[] = { 0x01
+		, 37
+		, 0x21, 0x35, 0xD9
+		, 3, 0xDA, 0xBE, 0xEF
+		, 0x42, 4, 0xFE, 0xE1, 0xAB, 0xBA
+		, 0x12, 0, 'a', 'b' //2 octets
+	};
+	med::decoder_context<> ctx{ encoded };
+	PROTO proto;
+
+	ASSERT_FALSE(decode(med::octet_decoder{ctx}, proto));
+	EXPECT_EQ(med::error::invalid_value, med::get_error_ctx(ctx).get_error());
+	EXPECT_STREQ("url", med::get_error_ctx(ctx).name());
+}
+
+TEST(nothrow, encode_missing_ie)
+{
+	uint8_t buffer[32];
+	med::encoder_context<> ctx{ buffer };
+	PROTO proto;
+
+	auto& msg = proto.ref<MSG_SEQ>();
+	msg.ref<FLD_UC>().set(37);
+
+	ASSERT_FALSE(encode(med::octet_encoder{ctx}, proto));
+	auto const& err = med::get_error_ctx(ctx);
+	EXPECT_EQ(med::error::missing_ie, err.get_error());
+	EXPECT_STREQ("U16", err.name());
+	EXPECT_EQ(2, err.offset());
+}
+
+TEST(nothrow, encode_overflow)
+{
+	uint8_t buffer[4];
+	med::encoder_context<> ctx{ buffer };
+	PROTO proto;
+
+	auto& msg = proto.ref<MSG_SEQ>();
+	msg.ref<FLD_UC>().set(37);
+	msg.ref<FLD_U16>().set(0x35D9);
+	msg.ref<FLD_U24>().set(0xDABEEF);
+	msg.ref<FLD_IP>().set(0xFee1ABBA);
+
+	ASSERT_FALSE(encode(med::octet_encoder{ctx}, proto));
+	auto const& err = med::get_error_ctx(ctx);
+	EXPECT_EQ(med::error::overflow, err.get_error());
+	EXPECT_EQ(3, err.offset());
+
+	//the 1st error is kept
+	ASSERT_FALSE(encode(med::octet_encoder{ctx}, proto));
+	EXPECT_EQ(3, med::get_error_ctx(ctx).offset());
+}
+
+TEST(nothrow, out_of_memory)
+{
+	struct U16 : med::value<uint16_t> {};
+	struct MSG : med::sequence<
+		O< T<2>, U16, med::inf>
+	>{};
+
+	uint8_t buffer[1];
+	med::encoder_context<> ctx{ buffer };
+	MSG msg;
+
+	//inplace slot then no space in allocator
+	ASSERT_NE(nullptr, msg.ref<U16>().push_back(ctx));
+	EXPECT_EQ(nullptr, msg.ref<U16>().push_back(ctx));
+	auto const& err = med::get_error_ctx(ctx);
+	EXPECT_EQ(med::error::out_of_memory, err.get_error());
+}
+
+TEST(nothrow, decode_out_of_memory)
+{
+	struct U8 : med::value<uint8_t> {};
+	struct MSG : med::sequence<
+		O< T<1>, U8, med::inf >
+	>{};
+	struct CMSG : med::sequence<
+		O< T<2>, med::cold<U8> >
+	>{};
+
+	//instance beyond inplace w/o allocator
+	uint8_t const encoded[] = { 1, 1, 1, 2 };
+	med::decoder_context<> ctx{ encoded };
+	MSG msg;
+	ASSERT_FALSE(decode(med::octet_decoder{ctx}, msg));
+	EXPECT_EQ(med::error::out_of_memory, med::get_error_ctx(ctx).get_error());
+
+	//cold IE w/o allocator
+	uint8_t const cold[] = { 2, 3 };
+	ctx.reset(cold, sizeof(cold));
+	CMSG cmsg;
+	ASSERT_FALSE(decode(med::octet_decoder{ctx}, cmsg));
+	EXPECT_EQ(med::error::out_of_memory, med::get_error_ctx(ctx).get_error());
+
+	//inplace only with error reported into buffer
+	ctx.reset(encoded, sizeof(encoded));
+	msg.clear();
+	ASSERT_NE(nullptr, msg.ref<U8>().push_back(ctx.buffer()));
+	EXPECT_EQ(nullptr, msg.ref<U8>().push_back(ctx.buffer()));
+	EXPECT_EQ(med::error::out_of_memory, med::get_error_ctx(ctx).get_error());
+
+	//copy of cold IE w/o allocator
+	uint8_t mem[16];
+	med::allocator alloc{mem};
+	CMSG src;
+	src.ref<med::cold<U8>>().emplace(alloc)->set(3);
+	ctx.reset(cold, sizeof(cold));
+	cmsg.clear();
+	cmsg.copy(src, ctx.buffer());
+	EXPECT_FALSE(cmsg.is_set());
+	EXPECT_EQ(med::error::out_of_memory, med::get_error_ctx(ctx).get_error());
+}
+
+TEST(nothrow, bits_overflow)
+{
+	uint8_t buffer[1];
+	med::encoder_context<> ctx{ buffer };
+	med::bits_variable bits;
+
+	bits.uint(med::nbits{65}, 1, ctx);
+	EXPECT_FALSE(bits.is_set());
+	EXPECT_EQ(med::error::invalid_value, med::get_error_ctx(ctx).get_error());
+
+	//too many bits to get as integer
+	ctx.reset();
+	uint8_t const octets[9] = {};
+	bits.assign_bits(octets, med::nbits{72});
+	EXPECT_EQ(0, bits.uint(ctx));
+	EXPECT_EQ(med::error::invalid_value, med::get_error_ctx(ctx).get_error());
+}
+
+TEST(nothrow, ber)
+{
+	uint8_t const encoded[] = { 0x02, 0x05, 0x01 }; //INTEGER with length beyond the end
+	med::decoder_context<> ctx{ encoded };
+	med::asn::integer ie;
+
+	ASSERT_FALSE(decode(med::asn::ber::decoder{ctx}, ie));
+	EXPECT_EQ(med::error::overflow, med::get_error_ctx(ctx).get_error());
+
+	uint8_t const wrong_tag[] = { 0x04, 0x01, 0x01 };
+	ctx.reset(wrong_tag, sizeof(wrong_tag));
+	ASSERT_FALSE(decode(med::asn::ber::decoder{ctx}, ie));
+	EXPECT_EQ(med::error::unknown_tag, med::get_error_ctx(ctx).get_error());
+}
+
+TEST(nothrow, protobuf)
+{
+	using tag = med::value<med::fixed<med::protobuf::field_tag(1, med::protobuf::wire_type::VARINT), med::protobuf::field_type>>;
+	struct msg : med::sequence<
+		M< tag, med::protobuf::uint64 >
+	>{};
+
+	//varint with no terminating byte
+	uint8_t const encoded[] = { 0x08, 0x80, 0x80 };
+	med::decoder_context<> ctx{ encoded };
+	msg m;
+
+	ASSERT_FALSE(decode(med::protobuf::decoder{ctx}, m));
+	EXPECT_EQ(med::error::overflow, med::get_error_ctx(ctx).get_error());
+	EXPECT_EQ(3, med::get_error_ctx(ctx).offset());
+}
+
+TEST(nothrow, stream)
+{
+	uint8_t const encoded[] = {
+		37
+		, 0x21, 0x35, 0xD9
+		, 3, 0xDA, 0xBE, 0xEF
+		, 0x42, 4, 0xFE, 0xE1, 0xAB, 0xBA
+	};
+	med::decoder_context<> ctx;
+	med::stream_decoder sd{ctx};
+	MSG_SEQ msg;
+
+	sd.reset(encoded, 6);
+	ASSERT_FALSE(sd.decode(msg));
+	EXPECT_FALSE(med::get_error_ctx(ctx)); //not an error
+	EXPECT_EQ(2, sd.need());
+	EXPECT_EQ(4, sd.offset());
+
+	sd.append(sizeof(encoded) - 6);
+	ASSERT_TRUE(sd.decode(msg));
+	EXPECT_EQ(0xFEE1ABBA, msg.get<FLD_IP>().get());
+
+	uint8_t const invalid[] = { 37, 0x22 };
+	sd.reset(invalid);
+	ASSERT_FALSE(sd.decode(msg));
+	EXPECT_EQ(0, sd.need());
+	EXPECT_EQ(med::error::unknown_tag, med::get_error_ctx(ctx).get_error());
+}
+
+TEST(nothrow, framer)
+{
+	struct MSG : med::sequence<
+		M< FLD_U16 >
+	>, med::add_meta_info< med::add_tag<T<1>>, med::add_len<med::value<uint8_t>> >
+	{};
+	uint8_t const encoded[] = {
+		1, 2, 0x12, 0x34
+		, 1, 2, 0x56, 0x78
+		, 2, 2, 0x9A, 0xBC
+	};
+	med::decoder_context<> ctx;
+	med::framer<MSG> framer{ctx};
+
+	framer.reset(encoded, 7);
+	ASSERT_EQ(4, framer.next().size());
+	MSG msg;
+	ASSERT_TRUE(framer.decode(msg));
+	EXPECT_EQ(0x1234, msg.get<FLD_U16>().get());
+
+	EXPECT_TRUE(framer.next().empty());
+	EXPECT_FALSE(med::get_error_ctx(ctx)); //not an error
+	EXPECT_EQ(1, framer.need());
+	EXPECT_EQ(4, framer.offset());
+
+	framer.append(sizeof(encoded) - 7);
+	ASSERT_EQ(4, framer.next().size());
+	EXPECT_TRUE(framer.next().empty());
+	EXPECT_EQ(med::error::unknown_tag, med::get_error_ctx(ctx).get_error());
+
+	//too long message is not waited for
+	med::framer<MSG> limited{ctx, 3};
+	limited.reset(encoded, 2);
+	EXPECT_TRUE(limited.next().empty());
+	EXPECT_EQ(med::error::invalid_value, med::get_error_ctx(ctx).get_error());
+	EXPECT_EQ(0, limited.need());
+}
+
+int main(int argc, char **argv)
+{
+	::testing::InitGoogleTest(&argc, argv);
+	return RUN_ALL_TESTS();
+}
@@ -1,4 +1,7 @@
+#include <vector>
+
 #include "ut.hpp"
+#include "iovec_buffer.hpp"
 
 
 struct var_intern : med::octet_string<med::octets_var_intern<8>, med::min<0>> {};
@@ -314,3 +317,73 @@ TEST(octets, ascii_string)
 	s.set(arr);
 	EXPECT_EQ(s.get().size(), std::strlen(arr));
 }
+
+namespace gather {
+
+using PL = med::length_t<med::value<uint16_t, med::padding<uint32_t>>>;
+
+struct payload : med::octet_string<med::octets_var_extern> {};
+struct trailer : med::octet_string<med::octets_var_extern> {};
+
+struct MSG : med::sequence<
+	M< T<1>, PL, payload >,
+	O< T<2>, L, var_extern >,
+	O< T<3>, L, trailer >
+>
+{};
+
+} //end: namespace gather
+
+TEST(octets, gather)
+{
+	using namespace gather;
+	uint8_t data[200];
+	for (std::size_t i = 0; i < sizeof(data); ++i) { data[i] = uint8_t(i); }
+	uint8_t const in[] = {1,2,3,4,5};
+
+	MSG msg;
+	msg.ref<payload>().set(131, data);
+	msg.ref<var_extern>().set(in);
+	msg.ref<trailer>().set(150, data + 10);
+
+	//reference output
+	uint8_t plain[512];
+	med::encoder_context<> pctx{ plain };
+	encode(med::octet_encoder{pctx}, msg);
+
+	//only the 1st payload is referred as no more segments available
+	uint8_t buffer[256];
+	med::encoder_context<const med::null_allocator, med::iovec_buffer<4>> ctx{ buffer };
+	encode(med::octet_encoder{ctx}, msg);
+
+	auto const iov = ctx.buffer().iov();
+	ASSERT_EQ(3, iov.size());
+	EXPECT_EQ(3, iov[0].iov_len); //T+L
+	EXPECT_EQ(data, iov[1].iov_base);
+	EXPECT_EQ(131, iov[1].iov_len);
+	EXPECT_EQ(pctx.buffer().get_offset(), ctx.buffer().total_size());
+
+	std::vector<uint8_t> out;
+	for (auto const& v : iov)
+	{
+		auto const* p = static_cast<uint8_t const*>(v.iov_base);
+		out.insert(out.end(), p, p + v.iov_len);
+	}
+	ASSERT_EQ(pctx.buffer().get_offset(), out.size());
+	EXPECT_TRUE(Matches(plain, out.data(), out.size()));
+
+	//rolled back to the start the chain is the same when re-encoded
+	ctx.reset();
+	auto const start = ctx.buffer().get_state();
+	encode(med::octet_encoder{ctx}, msg);
+	ctx.buffer().set_state(start);
+	EXPECT_EQ(0, ctx.buffer().total_size());
+	EXPECT_EQ(0, ctx.buffer().iov().size());
+	encode(med::octet_encoder{ctx}, msg);
+	auto const riov = ctx.buffer().iov();
+	ASSERT_EQ(iov.size(), riov.size());
+	EXPECT_EQ(3, riov[0].iov_len);
+	EXPECT_EQ(data, riov[1].iov_base);
+	EXPECT_EQ(131, riov[1].iov_len);
+	EXPECT_EQ(pctx.buffer().get_offset(), ctx.buffer().total_size());
+}
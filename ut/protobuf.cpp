@@ -3,6 +3,7 @@
 #include "protobuf/protobuf.hpp"
 #include "protobuf/encoder.hpp"
 #include "protobuf/decoder.hpp"
+#include "reverse_buffer.hpp"
 
 using namespace med::protobuf;
 
@@ -34,6 +35,31 @@ uint8_t const plain_encoded[] = {
 	0x20, 0x80, 0x02, //(T{4}<<3)|Varint{0}, value{256}
 };
 
+/*
+message inner {
+	uint32   uint_32 = 1;
+	bytes    data    = 2;
+}
+message outer {
+	uint64   uint_64 = 1;
+	inner    nested  = 2;
+}
+*/
+struct len : med::value<uint32_t> {};
+using L = med::length_t<len>;
+
+struct payload : med::octet_string<> {};
+
+struct inner : med::sequence<
+	O< T<1, wire_type::VARINT>, uint32 >,
+	O< T<2, wire_type::LEN_DELIM>, L, payload >
+>{};
+
+struct outer : med::sequence<
+	O< T<1, wire_type::VARINT>, uint64 >,
+	O< T<2, wire_type::LEN_DELIM>, L, inner >
+>{};
+
 } //end: namespace pb
 
 #define OPT_CHECK(MSG, FIELD, VALUE) \
@@ -73,3 +99,41 @@ TEST(protobuf, decode_plain)
 	OPT_CHECK(cmsg, uint32, 128);
 	OPT_CHECK(cmsg, uint64, 256);
 }
+
+TEST(protobuf, encode_reverse)
+{
+	//nested length is known when encoded back-to-front
+	pb::outer msg;
+	msg.ref<uint64>().set(300);
+	auto& nested = msg.ref<pb::inner>();
+	nested.ref<uint32>().set(1);
+	uint8_t data[150];
+	for (std::size_t i = 0; i < sizeof(data); ++i) { data[i] = uint8_t(i); }
+	nested.ref<pb::payload>().set(sizeof(data), data);
+
+	uint8_t buffer[256];
+	med::encoder_context<med::null_allocator const, med::reverse_buffer<>> ctx{ buffer };
+	encode(med::protobuf::encoder{ctx}, msg);
+
+	uint8_t const prefix[] = {
+		0x08, 0xAC, 0x02, //(T{1}<<3)|Varint{0}, value{300}
+		0x12, 0x9B, 0x01, //(T{2}<<3)|LenDelim{2}, len{155}
+		0x08, 0x01, //(T{1}<<3)|Varint{0}, value{1}
+		0x12, 0x96, 0x01, //(T{2}<<3)|LenDelim{2}, len{150}
+	};
+	ASSERT_EQ(sizeof(prefix) + sizeof(data), ctx.buffer().get_offset());
+	EXPECT_TRUE(Matches(prefix, ctx.buffer().get_start()));
+	EXPECT_TRUE(Matches(data, ctx.buffer().get_start() + sizeof(prefix)));
+
+	pb::outer dmsg;
+	med::decoder_context<> dctx{ ctx.buffer().used() };
+	decode(med::protobuf::decoder{dctx}, dmsg);
+	OPT_CHECK(dmsg, uint64, 300);
+	auto const* dnested = dmsg.get<pb::inner>();
+	ASSERT_NE(nullptr, dnested);
+	OPT_CHECK((*dnested), uint32, 1);
+	auto const* ddata = dnested->get<pb::payload>();
+	ASSERT_NE(nullptr, ddata);
+	ASSERT_EQ(sizeof(data), ddata->size());
+	EXPECT_TRUE(Matches(data, ddata->data()));
+}
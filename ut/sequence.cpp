@@ -2,6 +2,8 @@
 
 #include "ut.hpp"
 #include "ut_proto.hpp"
+#include "cold.hpp"
+#include "lazy.hpp"
 
 
 TEST(seq, bits)
@@ -25,6 +27,47 @@ TEST(seq, bits)
 	check_octet_decode(v, {0b1011'0110, 0b1110'1101});
 }
 
+TEST(seq, fixed_run)
+{
+	struct RUN : med::sequence<
+		M< FLD_UC >,
+		M< FLD_U16 >,
+		M< FLD_U24 >,
+		O< T<1>, FLD_U8 >
+	>{};
+	using ies = RUN::ies_types;
+	static_assert(6 == med::sl::fixed_run_size<M<FLD_UC>, ies>);
+	static_assert(med::sl::in_fixed_run<M<FLD_U16>, M<FLD_U24>, ies>);
+	static_assert(0 == med::sl::fixed_run_size<M<FLD_U24>, ies>);
+	static_assert(not med::sl::in_fixed_run<M<FLD_U24>, O<T<1>, FLD_U8>, ies>);
+
+	RUN msg;
+	msg.ref<FLD_UC>().set(1);
+	msg.ref<FLD_U16>().set(0x0203);
+	msg.ref<FLD_U24>().set(0x040506);
+	check_octet_encode(msg, {1, 2,3, 4,5,6});
+	check_octet_decode(msg, {1, 2,3, 4,5,6});
+
+	//the space is checked once at the start of run
+	uint8_t const encoded[] = {1, 2,3, 4,5};
+	med::decoder_context<> ctx{ encoded };
+	try
+	{
+		decode(med::octet_decoder{ctx}, msg);
+		FAIL() << "overflow expected";
+	}
+	catch (med::overflow const& ex)
+	{
+		EXPECT_EQ(6, ex.bytes());
+		EXPECT_EQ(0, ex.offset());
+	}
+
+	uint8_t buffer[5];
+	med::encoder_context<> ectx{ buffer };
+	EXPECT_THROW(encode(med::octet_encoder{ectx}, msg), med::overflow);
+	EXPECT_EQ(0, ectx.buffer().get_offset());
+}
+
 TEST(seq, ooo) //out-of-order
 {
 	OOO_SEQ msg;
@@ -872,3 +915,204 @@ TEST(seq, dec_alloc_fail)
 
 	ASSERT_THROW(decode(med::octet_decoder{ctx}, msg), med::out_of_memory);
 }
+
+namespace lazy {
+
+struct U8  : med::value<uint8_t> {};
+struct U16 : med::value<uint16_t> {};
+struct U32 : med::value<uint32_t> {};
+struct INNER : med::sequence<
+	M< T<1>, U8 >,
+	M< T<2>, U16 >
+>{};
+struct STR : med::ascii_string<> {};
+struct MSG : med::sequence<
+	M< U32 >,
+	M< T<3>, L, med::lazy<INNER> >,
+	O< T<4>, L, med::lazy<STR> >
+>{};
+struct ARR : med::sequence<
+	M< med::counter_t<U8>, U16, med::max<2> >,
+	M< T<1>, U8 >
+>{};
+struct LMSG : med::sequence<
+	M< T<3>, L, med::lazy<ARR> >
+>{};
+
+} //end: namespace lazy
+
+TEST(seq, lazy)
+{
+	uint8_t const encoded[] = {
+		0x12, 0x34, 0x56, 0x78,
+		3, 5, 1, 0x11, 2, 0x22, 0x33,
+		4, 2, 'a', 'b',
+	};
+	med::decoder_context<> ctx{ encoded };
+
+	lazy::MSG msg;
+	decode(med::octet_decoder{ctx}, msg);
+	EXPECT_EQ(0x12345678, msg.get<lazy::U32>().get());
+
+	//only the octets are recorded until accessed
+	auto const& inner = msg.get<med::lazy<lazy::INNER>>();
+	EXPECT_FALSE(inner.decoded());
+	EXPECT_EQ(encoded + 6, inner.data());
+	EXPECT_EQ(5, inner.size());
+
+	auto const* pi = inner.get();
+	ASSERT_NE(nullptr, pi);
+	EXPECT_TRUE(inner.decoded());
+	EXPECT_EQ(0x11, pi->get<lazy::U8>().get());
+	EXPECT_EQ(0x2233, pi->get<lazy::U16>().get());
+
+	auto const* ps = msg.get<med::lazy<lazy::STR>>();
+	ASSERT_NE(nullptr, ps);
+	EXPECT_FALSE(ps->decoded());
+	ASSERT_NE(nullptr, ps->get());
+	EXPECT_EQ("ab"sv, ps->get()->get());
+
+	//forwarded as is
+	uint8_t buffer[sizeof(encoded)];
+	med::encoder_context<> ectx{ buffer };
+	encode(med::octet_encoder{ectx}, msg);
+	EXPECT_EQ(sizeof(encoded), ectx.buffer().get_offset());
+	EXPECT_TRUE(Matches(encoded, buffer));
+
+	//invalid IE is detected on access only
+	uint8_t const invalid[] = {
+		0x12, 0x34, 0x56, 0x78,
+		3, 5, 1, 0x11, 3, 0x22, 0x33,
+	};
+	ctx.reset(invalid, sizeof(invalid));
+	msg.clear();
+	decode(med::octet_decoder{ctx}, msg);
+	EXPECT_THROW(msg.get<med::lazy<lazy::INNER>>().get(), med::unknown_tag);
+
+	//failed access leaves nothing behind for the next one
+	uint8_t const partial[] = {
+		3, 7, 2, 0x00, 0x01, 0x00, 0x02, 5, 0x11,
+	};
+	ctx.reset(partial, sizeof(partial));
+	lazy::LMSG lmsg;
+	decode(med::octet_decoder{ctx}, lmsg);
+	auto const& arr = lmsg.get<med::lazy<lazy::ARR>>();
+	EXPECT_THROW(arr.get(), med::unknown_tag);
+	EXPECT_THROW(arr.get(), med::unknown_tag);
+	EXPECT_FALSE(arr.decoded());
+}
+
+namespace cold {
+
+struct U8  : med::value<uint8_t> {};
+struct U16 : med::value<uint16_t> {};
+struct STR : med::ascii_string<med::octets_var_intern<64>, med::min<0>> {};
+struct VENDOR : med::sequence<
+	M< T<1>, U16 >,
+	O< T<2>, L, STR >
+>{};
+struct MSG : med::sequence<
+	M< T<1>, U8 >,
+	O< T<2>, L, med::cold<VENDOR> >,
+	O< T<3>, med::cold<U16> >
+>{};
+
+} //end: namespace cold
+
+TEST(seq, cold)
+{
+	static_assert(sizeof(cold::MSG) < sizeof(cold::VENDOR));
+	uint8_t mem[256];
+	med::allocator alloc{mem};
+
+	//absent IEs take no space
+	uint8_t const hot[] = { 1, 0x11 };
+	med::decoder_context<med::allocator> ctx{ hot, &alloc };
+	cold::MSG msg;
+	decode(med::octet_decoder{ctx}, msg);
+	EXPECT_EQ(0x11, msg.get<cold::U8>().get());
+	EXPECT_EQ(nullptr, msg.get<med::cold<cold::VENDOR>>());
+	EXPECT_EQ(nullptr, msg.get<med::cold<cold::U16>>());
+	EXPECT_EQ(mem, alloc.allocate(1, 1));
+	alloc.release();
+
+	uint8_t const encoded[] = {
+		1, 0x11,
+		2, 8, 1, 0x12, 0x34, 2, 3, 'a', 'b', 'c',
+		3, 0x56, 0x78,
+	};
+	ctx.reset(encoded, sizeof(encoded));
+	msg.clear();
+	decode(med::octet_decoder{ctx}, msg);
+	auto const* pv = msg.get<med::cold<cold::VENDOR>>();
+	ASSERT_NE(nullptr, pv);
+	auto const* vendor = pv->get();
+	EXPECT_LE(uintptr_t(mem), uintptr_t(vendor));
+	EXPECT_GT(uintptr_t(mem + sizeof(mem)), uintptr_t(vendor));
+	EXPECT_EQ(0x1234, vendor->get<cold::U16>().get());
+	EXPECT_EQ("abc"sv, vendor->get<cold::STR>()->get());
+	auto const* pu = msg.get<med::cold<cold::U16>>();
+	ASSERT_NE(nullptr, pu);
+	EXPECT_EQ(0x5678, pu->get()->get());
+
+	uint8_t buffer[sizeof(encoded)];
+	med::encoder_context<> ectx{ buffer };
+	encode(med::octet_encoder{ectx}, msg);
+	EXPECT_EQ(sizeof(encoded), ectx.buffer().get_offset());
+	EXPECT_TRUE(Matches(encoded, buffer));
+
+	//copy allocates the IEs present only
+	uint8_t cmem[256];
+	med::allocator calloc{cmem};
+	cold::MSG dst;
+	dst.copy(msg, calloc);
+	EXPECT_EQ(msg, dst);
+
+	//w/o allocator into the IEs allocated already only
+	cold::MSG ndst;
+	EXPECT_THROW(ndst.copy(msg), med::out_of_memory);
+	dst.clear();
+	dst.copy(msg);
+	EXPECT_EQ(msg, dst);
+
+	//cleared keeping the IEs allocated to be reused when set
+	auto const* u16 = pu->get();
+	msg.clear();
+	EXPECT_NE(msg, dst);
+	EXPECT_EQ(nullptr, msg.get<med::cold<cold::U16>>());
+	msg.ref<cold::U8>().set(0x11);
+	auto* pset = msg.ref<med::cold<cold::U16>>().emplace(alloc);
+	EXPECT_EQ(u16, pset);
+	pset->set(0x5678);
+	ectx.reset();
+	encode(med::octet_encoder{ectx}, msg);
+	uint8_t const set[] = { 1, 0x11, 3, 0x56, 0x78 };
+	EXPECT_EQ(sizeof(set), ectx.buffer().get_offset());
+	EXPECT_TRUE(Matches(set, buffer));
+
+	//reset drops them before the allocator is released
+	msg.reset();
+	EXPECT_FALSE(msg.is_set());
+	EXPECT_EQ(nullptr, msg.ref<med::cold<cold::U16>>().emplace());
+	alloc.release();
+	EXPECT_GT(uintptr_t(mem) + alignof(cold::U16), uintptr_t(msg.ref<med::cold<cold::U16>>().emplace(alloc)));
+}
+
+TEST(seq, cold_validate)
+{
+	uint8_t const encoded[] = {
+		1, 0x11,
+		2, 8, 1, 0x12, 0x34, 2, 3, 'a', 'b', 'c',
+		3, 0x56, 0x78,
+	};
+	//w/o allocator
+	med::decoder_context<> ctx{ encoded };
+	EXPECT_NO_THROW(med::validate<cold::MSG>(med::octet_decoder{ctx}));
+
+	uint8_t const truncated[] = {
+		1, 0x11,
+		2, 4, 1, 0x12, 0x34, 2,
+	};
+	ctx.reset(truncated, sizeof(truncated));
+	EXPECT_THROW(med::validate<cold::MSG>(med::octet_decoder{ctx}), med::overflow);
+}
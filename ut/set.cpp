@@ -355,6 +355,56 @@ TEST(decode, set_ok)
 	EQ_STRING_O(VFLD1, "test.this");
 }
 
+namespace sparse {
+
+template <uint32_t TAG>
+using T32 = med::value<med::fixed<TAG, uint32_t>>;
+template <std::size_t N>
+struct V : med::value<uint8_t> {};
+
+//tags far apart to be dispatched via perfect hash
+struct SET : med::set<
+	M< T32<1>, V<0> >,
+	O< T32<1000>, V<1> >,
+	O< T32<70000>, V<2> >,
+	O< T32<0x1000000>, V<3> >,
+	O< T32<0xDEADBEEF>, V<4> >,
+	O< T32<0xFFFFFFFF>, V<5> >
+>{};
+
+} //end: namespace sparse
+
+TEST(decode, set_sparse_tags)
+{
+	uint8_t const encoded[] = {
+		0xDE, 0xAD, 0xBE, 0xEF, 4,
+		0, 0, 0, 1, 0,
+		0xFF, 0xFF, 0xFF, 0xFF, 5,
+		0, 1, 0x11, 0x70, 2,
+	};
+	med::decoder_context<> ctx{ encoded };
+	sparse::SET msg;
+	decode(med::octet_decoder{ctx}, msg);
+
+	EXPECT_EQ(0, msg.get<sparse::V<0>>().get());
+	EXPECT_EQ(nullptr, msg.get<sparse::V<1>>());
+	ASSERT_NE(nullptr, msg.get<sparse::V<2>>());
+	EXPECT_EQ(2, msg.get<sparse::V<2>>()->get());
+	EXPECT_EQ(nullptr, msg.get<sparse::V<3>>());
+	ASSERT_NE(nullptr, msg.get<sparse::V<4>>());
+	EXPECT_EQ(4, msg.get<sparse::V<4>>()->get());
+	ASSERT_NE(nullptr, msg.get<sparse::V<5>>());
+	EXPECT_EQ(5, msg.get<sparse::V<5>>()->get());
+
+	uint8_t const unknown[] = {
+		0, 0, 0, 1, 0,
+		0, 0, 0x03, 0xE9, 1,
+	};
+	ctx.reset(unknown, sizeof(unknown));
+	sparse::SET umsg;
+	EXPECT_THROW(decode(med::octet_decoder{ctx}, umsg), med::unknown_tag);
+}
+
 TEST(decode, set_fail)
 {
 	PROTO proto;
@@ -604,3 +654,181 @@ TEST(decode, set_func_fail)
 	ctx.reset(encoded2);
 	EXPECT_THROW(decode(med::octet_decoder{ctx}, proto), med::extra_ie);
 }
+
+namespace sel {
+
+struct U8  : med::value<uint8_t> {};
+struct U16 : med::value<uint16_t> {};
+struct ID  : med::value<uint16_t> {};
+struct STR : med::octet_string<med::min<2>> {};
+
+struct SET : med::set<
+	M< T<1>, L, U16 >,
+	M< T<2>, L, STR >,
+	O< T<3>, L, U8, med::inf >,
+	M< T<4>, ID >,
+	O< T<5>, med::length_t<med::value<uint32_t>>, STR >
+>{};
+
+struct SEQ : med::sequence<
+	M< L, STR >,
+	M< U8 >
+>{};
+
+struct FLAGS : med::value<uint8_t>
+{
+	struct has_str
+	{
+		template <class T> bool operator()(T const& ies) const
+		{
+			return ies.template as<FLAGS>().get() & 1;
+		}
+	};
+};
+
+struct CSEQ : med::sequence<
+	M< FLAGS >,
+	O< L, STR, FLAGS::has_str >,
+	M< U8 >
+>{};
+
+} //end: namespace sel
+
+TEST(decode, set_select)
+{
+	uint8_t const encoded[] = {
+		3, 1, 5,
+		2, 1, 0xFF, //too short
+		1, 2, 0x12, 0x34,
+		3, 1, 6,
+		4, 0x56, 0x78,
+	};
+	med::decoder_context<> ctx{ encoded };
+
+	//needs allocator and fails on the value
+	sel::SET msg;
+	EXPECT_THROW(decode(med::octet_decoder{ctx}, msg), med::exception);
+
+	//other IEs are skipped w/o decoding and storing
+	ctx.reset(encoded, sizeof(encoded));
+	sel::SET smsg;
+	decode<sel::U16>(med::octet_decoder{ctx}, smsg);
+	EXPECT_EQ(0x1234, smsg.get<sel::U16>().get());
+	EXPECT_FALSE(smsg.get<sel::STR>().is_set());
+	EXPECT_EQ(0, smsg.get<sel::U8>().count());
+
+	//mandatory selected IE is still checked
+	uint8_t const missing[] = {
+		2, 2, 0xAB, 0xCD,
+		4, 0x56, 0x78,
+	};
+	ctx.reset(missing, sizeof(missing));
+	sel::SET mmsg;
+	EXPECT_THROW(decode<sel::U16>(med::octet_decoder{ctx}, mmsg), med::missing_ie);
+
+	uint8_t const seq[] = { 1, 0xFF, 0x55 }; //too short
+	ctx.reset(seq, sizeof(seq));
+	sel::SEQ sq;
+	decode<sel::U8>(med::octet_decoder{ctx}, sq);
+	EXPECT_EQ(0x55, sq.get<sel::U8>().get());
+
+	//length of skipped IE beyond the buffer
+	uint8_t const huge[] = {
+		1, 2, 0x12, 0x34,
+		5, 0x80, 0, 0, 0, 0xAB, 0xCD, //would be negative as int
+		4, 0x56, 0x78,
+	};
+	ctx.reset(huge, sizeof(huge));
+	sel::SET hmsg;
+	EXPECT_THROW(decode<sel::U16>(med::octet_decoder{ctx}, hmsg), med::overflow);
+
+	//IEs w/o length aren't skipped but decoded
+	ctx.reset(encoded, sizeof(encoded));
+	sel::SET vmsg;
+	decode<sel::U16>(med::octet_decoder{ctx}, vmsg);
+	EXPECT_EQ(0x5678, vmsg.get<sel::ID>().get());
+
+	//so conditions can refer them
+	uint8_t const cseq[] = { 1, 2, 0xAB, 0xCD, 0x55 };
+	ctx.reset(cseq, sizeof(cseq));
+	sel::CSEQ cs;
+	decode<sel::U8>(med::octet_decoder{ctx}, cs);
+	EXPECT_EQ(1, cs.get<sel::FLAGS>().get());
+	EXPECT_EQ(nullptr, cs.get<sel::STR>());
+	EXPECT_EQ(0x55, cs.get<sel::U8>().get());
+
+	uint8_t const nstr[] = { 0, 0x55 };
+	ctx.reset(nstr, sizeof(nstr));
+	cs.clear();
+	decode<sel::U8>(med::octet_decoder{ctx}, cs);
+	EXPECT_EQ(0x55, cs.get<sel::U8>().get());
+}
+
+namespace gen {
+
+struct U8 : med::value<uint8_t, med::packed> {};
+struct SEQ : med::sequence<
+	M< FLD_UC >,
+	O< T<2>, FLD_U16 >
+>{};
+struct SET : med::set<
+	med::generation<>,
+	M< T<1>, FLD_UC >,
+	O< T<2>, FLD_U16 >,
+	O< T<3>, FLD_U8, med::max<3> >,
+	O< T<4>, U8 >,
+	O< T<5>, L, SEQ >
+>{};
+
+} //end: namespace gen
+
+TEST(decode, set_generation)
+{
+	uint8_t const encoded[] = {
+		1, 0x11,
+		2, 0x12, 0x34,
+		3, 5,
+		3, 6,
+		4, 7,
+		5, 4, 0x21, 2, 0x56, 0x78,
+	};
+	med::decoder_context<> ctx{ encoded };
+	gen::SET msg;
+	decode(med::octet_decoder{ctx}, msg);
+	ASSERT_EQ(2, msg.count<FLD_U8>());
+	ASSERT_NE(nullptr, msg.get<gen::SEQ>());
+	EXPECT_EQ(0x5678, msg.get<gen::SEQ>()->get<FLD_U16>()->get());
+
+	//nothing is cleared but all IEs look cleared
+	msg.clear();
+	gen::SET const& cmsg = msg;
+	EXPECT_FALSE(cmsg.is_set());
+	EXPECT_EQ(nullptr, cmsg.get<FLD_U16>());
+	EXPECT_EQ(0, cmsg.count<FLD_U8>());
+	EXPECT_EQ(nullptr, cmsg.get<gen::U8>());
+	EXPECT_EQ(nullptr, cmsg.get<gen::SEQ>());
+	EXPECT_TRUE(cmsg == gen::SET{});
+
+	//IEs decoded again are cleared before
+	uint8_t const partial[] = {
+		3, 8,
+		1, 0x22,
+		5, 1, 0x23,
+	};
+	ctx.reset(partial, sizeof(partial));
+	decode(med::octet_decoder{ctx}, msg);
+	EXPECT_EQ(0x22, msg.get<FLD_UC>().get());
+	EXPECT_EQ(nullptr, msg.get<FLD_U16>());
+	ASSERT_EQ(1, msg.count<FLD_U8>());
+	EXPECT_EQ(8, msg.get<FLD_U8>().first()->get());
+	EXPECT_EQ(nullptr, msg.get<gen::U8>());
+	ASSERT_NE(nullptr, msg.get<gen::SEQ>());
+	EXPECT_EQ(nullptr, msg.get<gen::SEQ>()->get<FLD_U16>());
+	check_octet_encode(msg, {1, 0x22, 3, 8, 5, 1, 0x23});
+
+	//IE untouched since counter wrapped is still cleared
+	msg.ref<FLD_U16>().set(1);
+	for (std::size_t i = 0; i < 256; ++i) { msg.clear(); }
+	EXPECT_EQ(nullptr, msg.get<FLD_U16>());
+	EXPECT_EQ(0, msg.count<FLD_U8>());
+}
@@ -0,0 +1,181 @@
+#include "ut.hpp"
+#include "ut_proto.hpp"
+#include "stream_decoder.hpp"
+#include "file_reader.hpp"
+
+#include <atomic>
+#include <cstdio>
+
+TEST(stream, resume)
+{
+	uint8_t encoded[] = {
+		37
+		, 0x21, 0x35, 0xD9
+		, 3, 0xDA, 0xBE, 0xEF
+		, 0x42, 4, 0xFE, 0xE1, 0xAB, 0xBA
+	};
+	med::decoder_context<> ctx;
+	med::stream_decoder sd{ctx};
+	MSG_SEQ msg;
+
+	sd.reset(encoded, 2);
+	ASSERT_FALSE(sd.decode(msg));
+	EXPECT_EQ(2, sd.need()); //U16 after the tag
+	EXPECT_EQ(1, sd.offset());
+	//decoded IE is not parsed again
+	encoded[0] = 0xFF;
+
+	sd.append(1);
+	EXPECT_EQ(1, sd.need());
+	ASSERT_FALSE(sd.decode(msg)); //not even tried
+
+	sd.append(2);
+	EXPECT_EQ(0, sd.need());
+	ASSERT_FALSE(sd.decode(msg));
+	EXPECT_EQ(3, sd.need()); //length of U24 is known
+	EXPECT_EQ(4, sd.offset());
+
+	sd.append(sizeof(encoded) - 5);
+	ASSERT_TRUE(sd.decode(msg));
+	EXPECT_EQ(0, sd.need());
+	EXPECT_EQ(sizeof(encoded), sd.offset());
+
+	EXPECT_EQ(37, msg.get<FLD_UC>().get());
+	EXPECT_EQ(0x35D9, msg.get<FLD_U16>().get());
+	EXPECT_EQ(0xDABEEF, msg.get<FLD_U24>().get());
+	EXPECT_EQ(0xFEE1ABBA, msg.get<FLD_IP>().get());
+}
+
+TEST(stream, multi)
+{
+	uint8_t const encoded[] = {
+		4, 0x0E
+		, 0x16, 0x03, 0x04 //<TV>*[1,2]
+		, 0x16, 0x03, 0x05
+	};
+	struct FLD_CNT : med::value<uint8_t> {};
+	struct MSG : med::sequence<
+		M< FLD_CNT >,
+		M< FLD_UC >,
+		M< T<0x16>, FLD_U16, med::max<2> >
+	>{};
+	med::decoder_context<> ctx;
+	med::stream_decoder sd{ctx};
+	MSG msg;
+
+	//partially decoded multi-field is started over
+	sd.reset(encoded, 6);
+	ASSERT_FALSE(sd.decode(msg));
+	EXPECT_EQ(2, sd.need());
+	EXPECT_EQ(2, sd.offset());
+
+	sd.append(2);
+	ASSERT_TRUE(sd.decode(msg));
+	auto const& u16 = msg.get<FLD_U16>();
+	ASSERT_EQ(2, u16.count());
+	EXPECT_EQ(0x0304, u16.first()->get());
+	EXPECT_EQ(0x0305, u16.last()->get());
+}
+
+TEST(stream, read_ahead)
+{
+	uint8_t const encoded[] = { 2, 0x11, 2, 0x22, 3, 0x33, 0x44 };
+	struct AA : med::value<uint8_t> {};
+	struct B : med::value<uint8_t> {};
+	struct CC : med::value<uint16_t> {};
+	struct MSG : med::sequence<
+		O< T<1>, AA >,
+		O< T<2>, B, med::max<4> >,
+		O< T<3>, CC >
+	>{};
+	med::decoder_context<> ctx;
+	med::stream_decoder sd{ctx};
+	MSG msg;
+
+	//no resume point w/ tag read ahead so decoded IEs past it are started over
+	sd.reset(encoded, 6);
+	ASSERT_FALSE(sd.decode(msg));
+	EXPECT_EQ(0, sd.offset());
+
+	sd.append(1);
+	ASSERT_TRUE(sd.decode(msg));
+	EXPECT_EQ(nullptr, msg.get<AA>());
+	auto const& b = msg.get<B>();
+	ASSERT_EQ(2, b.count());
+	EXPECT_EQ(0x11, b.first()->get());
+	EXPECT_EQ(0x22, b.last()->get());
+	ASSERT_NE(nullptr, msg.get<CC>());
+	EXPECT_EQ(0x3344, msg.get<CC>()->get());
+}
+
+TEST(stream, error)
+{
+	uint8_t const encoded[] = { 37, 0x22 };
+	med::decoder_context<> ctx;
+	med::stream_decoder sd{ctx};
+	MSG_SEQ msg;
+
+	//not partial but invalid data
+	sd.reset(encoded);
+	EXPECT_THROW(sd.decode(msg), med::unknown_tag);
+}
+
+TEST(stream, file_reader)
+{
+	struct NAME : med::octet_string<med::octets_var_extern, med::min<1>, med::max<16>> {};
+	struct CDR : med::sequence<
+		M< FLD_U16 >,
+		M< L, NAME >
+	>, med::add_meta_info< med::add_tag<T<1>>, med::add_len<med::value<uint16_t>> >
+	{};
+
+	constexpr std::size_t NUM = 100;
+	uint8_t encoded[NUM * 9];
+	std::size_t len = 0;
+	for (std::size_t i = 0; i < NUM; ++i)
+	{
+		uint8_t const rec[] = {1, 0, 6, 0, uint8_t(i), 3, 'c', 'd', uint8_t('0' + i % 10)};
+		std::memcpy(encoded + len, rec, sizeof(rec));
+		len += sizeof(rec);
+	}
+
+	med::file_reader<CDR> reader;
+	auto open = [&](std::size_t size)
+	{
+		char path[] = "/tmp/med_cdrXXXXXX";
+		int const fd = ::mkstemp(path);
+		bool const ok = fd >= 0 && ssize_t(size) == ::write(fd, encoded, size);
+		::close(fd);
+		return ok && reader.open(path) && 0 == ::unlink(path);
+	};
+	ASSERT_TRUE(open(len));
+	auto const file = reader.data();
+	ASSERT_EQ(len, file.size());
+
+	med::decoder_context<> ctx;
+	std::size_t sum = 0;
+	EXPECT_EQ(NUM, reader.for_each(ctx, [&](CDR const& cdr, auto record)
+	{
+		EXPECT_EQ(9, record.size());
+		sum += cdr.get<FLD_U16>().get();
+		//zero-copy into the mapping
+		EXPECT_EQ(record.data() + 6, cdr.get<NAME>().data());
+	}));
+	EXPECT_EQ(NUM * (NUM - 1) / 2, sum);
+
+	//split across threads
+	med::decoder_context<> ctxs[4];
+	std::atomic<std::size_t> asum{0};
+	EXPECT_EQ(NUM, reader.for_each(std::span{ctxs}, [&](CDR const& cdr, auto)
+	{
+		asum += cdr.get<FLD_U16>().get();
+	}));
+	EXPECT_EQ(NUM * (NUM - 1) / 2, asum.load());
+
+	//truncated last record
+	ASSERT_TRUE(open(len - 2));
+	EXPECT_THROW(reader.for_each(std::span{ctxs}, [](CDR const&, auto){}), med::overflow);
+
+	EXPECT_FALSE(reader.open("/nonexistent/med_cdr"));
+	EXPECT_TRUE(reader.data().empty());
+}
@@ -130,6 +130,66 @@ TEST(value, bytes)
 	check_octet_decode(v, {0,0,3});
 }
 
+TEST(value, packed)
+{
+	struct U8 : med::value<uint8_t, med::packed> {};
+	struct U16 : med::value<uint16_t, med::packed> {};
+	struct U32 : med::value<uint32_t, med::packed> {};
+	struct V16 : med::value<uint16_t, med::packed> {};
+	struct MSG : med::sequence<
+		M< U16 >,
+		O< T<1>, U32 >,
+		O< T<2>, U8 >,
+		O< T<3>, V16, med::max<2> >
+	>{};
+	struct SET : med::set<
+		O< T<1>, U32 >,
+		O< T<2>, U8 >
+	>{};
+	//no presence flags but the bitmap of container
+	static_assert(4 == sizeof(U32) && 1 == sizeof(U8));
+	static_assert(8 == sizeof(SET)); //4 + 1 + bitmap vs 8 + 2 w/ flags
+
+	MSG msg;
+	EXPECT_FALSE(msg.is_set());
+	EXPECT_FALSE(msg.get<U32>());
+	msg.ref<U16>().set(0x0102);
+	msg.ref<U32>().set(0x03040506);
+	EXPECT_TRUE(msg.is_set());
+	ASSERT_TRUE(msg.get<U32>());
+	EXPECT_EQ(0x03040506, msg.get<U32>()->get());
+	EXPECT_FALSE(msg.get<U8>());
+	check_octet_encode(msg, {1,2, 1, 3,4,5,6});
+	check_octet_decode(msg, {1,2, 1, 3,4,5,6});
+
+	MSG copy;
+	copy.copy(msg);
+	EXPECT_TRUE(msg == copy);
+	copy.ref<U32>().clear();
+	EXPECT_FALSE(copy.get<U32>());
+	EXPECT_FALSE(msg == copy);
+
+	//multi-instance values are present by count
+	msg.ref<U8>().set(7);
+	msg.ref<V16>().push_back()->set(8);
+	check_octet_encode(msg, {1,2, 1, 3,4,5,6, 2, 7, 3, 0,8});
+	check_octet_decode(msg, {1,2, 1, 3,4,5,6, 2, 7, 3, 0,8});
+
+	msg.clear();
+	EXPECT_FALSE(msg.is_set());
+	EXPECT_FALSE(msg.get<U8>());
+	EXPECT_EQ(0, msg.count<V16>());
+
+	SET set;
+	EXPECT_FALSE(set.is_set());
+	set.ref<U8>().set(9);
+	EXPECT_TRUE(set.is_set());
+	check_octet_encode(set, {2, 9});
+	check_octet_decode(set, {2, 9});
+	set.clear();
+	EXPECT_FALSE(set.is_set());
+}
+
 TEST(value, one_byte)
 {
 	{